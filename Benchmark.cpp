@@ -0,0 +1,36 @@
+//Benchmark suite of _Benchmark.h, one CSV file per table:
+//	Benchmark [n [repeats [path [table...]]]]
+//writes path<table>.csv for the tables named (sorts, threads, search, comparators, lists,
+//mixed), every table if none is. n is 2^20, repeats 3 and path "benchmark_" by default.
+//Build with the repo root on the include path:
+//	g++ -std=c++17 -O2 -march=native -pthread -I. Benchmark.cpp -o Benchmark
+//	cl /std:c++17 /O2 /EHsc /arch:AVX2 /I. Benchmark.cpp
+#include <cstdio>
+#include <cstdlib>
+#include <_Benchmark.h>
+
+int main(int argc, char** argv)
+{
+	int n(argc > 1 ? ::atoi(argv[1]) : 1 << 20);
+	int repeats(argc > 2 ? ::atoi(argv[2]) : 3);
+	char const* path(argc > 3 ? argv[3] : "benchmark_");
+	if (n < 1 || repeats < 1)
+	{
+		::fprintf(stderr, "usage: %s [n [repeats [path [table...]]]]\n", argv[0]);
+		return 1;
+	}
+	Benchmark benchmark(n, repeats);
+	if (argc <= 4)
+	{
+		if (benchmark.run(path))return 0;
+		::fprintf(stderr, "could not write the tables to %s...\n", path);
+		return 1;
+	}
+	for (int c0(4); c0 < argc; ++c0)
+		if (!benchmark.run(path, argv[c0]))
+		{
+			::fprintf(stderr, "no table %s, or %s%s.csv could not be written\n", argv[c0], path, argv[c0]);
+			return 1;
+		}
+	return 0;
+}
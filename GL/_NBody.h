@@ -15,7 +15,7 @@ namespace OpenGL
 				float mass;
 				Math::vec4<float>velocity;
 			};
-			Vector<Particle>particles;
+			AlignedVector<Particle>particles;
 			std::mt19937 mt;
 			std::uniform_real_distribution<float>randReal;
 			unsigned int num;
@@ -57,6 +57,7 @@ namespace OpenGL
 			void randomGalaxy()
 			{
 				unsigned int _num(num - 1);
+				particles.reserve(particles.length + num);
 				while (_num--)
 					particles.pushBack(flatGalaxyParticles());
 				particles.pushBack
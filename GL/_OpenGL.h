@@ -12,6 +12,7 @@
 #endif
 
 #include <_Vector.h>
+#include <_SmallVector.h>
 #include <_String.h>
 #include <_Array.h>
 #include <_Pair.h>
@@ -283,7 +284,7 @@ namespace OpenGL
 	struct VertexArrayBuffer
 	{
 		GLuint vao;
-		Vector<VertexAttrib*>attribs;
+		SmallVector<VertexAttrib*, 8>attribs;
 		VertexArrayBuffer()
 			:
 			vao(0)
@@ -336,7 +337,7 @@ namespace OpenGL
 	{
 		struct Source
 		{
-			using Attach = Vector<Pair<unsigned int, unsigned int>>;
+			using Attach = SmallVector<Pair<unsigned int, unsigned int>, 6>;
 			String<char>name;
 			Array<Vector<String<char>>, 6>source;
 			Attach attach;
@@ -356,7 +357,7 @@ namespace OpenGL
 	};
 	struct Program
 	{
-		using Attach = Vector<Pair<unsigned int, unsigned int>>;
+		using Attach = SmallVector<Pair<unsigned int, unsigned int>, 6>;
 
 		SourceManager* sourceManage;
 		String<char> name;
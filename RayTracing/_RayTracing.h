@@ -434,7 +434,7 @@ namespace RayTracing
 					vec4 paras;	//Ax + By + Cz + W = 0, this is (A, B, C, W).
 					Color color;
 				};
-				Vector<Plane>planes;
+				AlignedVector<Plane>planes;
 				PlaneData()
 					:
 					Data(DynamicDraw)
@@ -493,7 +493,7 @@ namespace RayTracing
 					vec4 uv3;
 					Color color;
 				};
-				Vector<TriangleOrigin>trianglesOrigin;
+				AlignedVector<TriangleOrigin>trianglesOrigin;
 				TriangleOriginData()
 					:
 					Data(DynamicDraw)
@@ -592,7 +592,7 @@ namespace RayTracing
 					vec4 e2;
 					Color color;
 				};
-				Vector<Sphere>spheres;
+				AlignedVector<Sphere>spheres;
 				SphereData()
 					:
 					Data(DynamicDraw)
@@ -653,7 +653,7 @@ namespace RayTracing
 					vec4 e1;			//e(unnormalized)
 					Color color;
 				};
-				Vector<Circle>circles;
+				AlignedVector<Circle>circles;
 				CircleData()
 					:
 					Data(DynamicDraw)
@@ -715,7 +715,7 @@ namespace RayTracing
 					vec4 e1;
 					Color color;
 				};
-				Vector<Cylinder> cylinders;
+				AlignedVector<Cylinder>cylinders;
 				CylinderData()
 					:
 					Data(DynamicDraw)
@@ -777,7 +777,7 @@ namespace RayTracing
 					vec4 e1;
 					Color color;
 				};
-				Vector<Cone>cones;
+				AlignedVector<Cone>cones;
 				ConeData()
 					:
 					Data(DynamicDraw)
@@ -835,7 +835,7 @@ namespace RayTracing
 					vec4 color;
 					vec4 p;
 				};
-				Vector<PointLight>pointLights;
+				AlignedVector<PointLight>pointLights;
 				PointLightData()
 					:
 					Data(StaticDraw)
@@ -1,114 +1,696 @@
 #pragma once
+#include <new>
+#include <utility>
+#include <thread>
+#ifdef _MSC_VER
+#include <xmmintrin.h>
+#endif
+#include <_Vector.h>
+#include <_Pair.h>
+#include <_SortingNetwork.h>
 
-template<class T>inline void maxHeap(T* const a, int p, int q)
+//Every sort and heap routine takes an optional comparator and projection: elements are
+//ordered by cmp(proj(a), proj(b)), so records can be sorted in place by any key:
+//	qsort(triangles.data, 0, triangles.length, Less(), [](STL::Triangle const& a) {return a.getMinEdgeLength(); });
+struct Less
 {
-	T l((p << 1) + 1);
-	T r((p + 1) << 1);
-	if (a[p] < a[l])
+	template<class A, class B>bool operator()(A const& a, B const& b)const
 	{
-		if (r < q && a[l] < a[r])
+		return a < b;
+	}
+};
+struct Greater
+{
+	template<class A, class B>bool operator()(A const& a, B const& b)const
+	{
+		return b < a;
+	}
+};
+struct Identity
+{
+	template<class A>A const& operator()(A const& a)const
+	{
+		return a;
+	}
+};
+
+//maxHeap: sift a[p] down in the max heap a[0, q)
+template<class T, class Compare = Less, class Projection = Identity>inline void maxHeap(T* const a, int p, int q, Compare cmp = Compare(), Projection proj = Projection())
+{
+	while (true)
+	{
+		int l((p << 1) + 1);
+		if (l >= q)return;
+		int r(l + 1);
+		int m(r < q && cmp(proj(a[l]), proj(a[r])) ? r : l);
+		if (!cmp(proj(a[p]), proj(a[m])))return;
+		std::swap(a[p], a[m]);
+		p = m;
+	}
+}
+//maxHeapUp: sift a[n] up in the max heap a[0, n]
+template<class T, class Compare = Less, class Projection = Identity>inline void maxHeapUp(T* const a, int n, Compare cmp = Compare(), Projection proj = Projection())
+{
+	while (n)
+	{
+		int p((n - 1) >> 1);
+		if (!cmp(proj(a[p]), proj(a[n])))return;
+		std::swap(a[p], a[n]);
+		n = p;
+	}
+}
+template<class T, class Compare = Less, class Projection = Identity>inline void maxTopHeap(T* const a, int q, Compare cmp = Compare(), Projection proj = Projection())
+{
+	maxHeap(a, 0, q, cmp, proj);
+}
+template<class T, class Compare = Less, class Projection = Identity>inline void buildMaxHeap(T* const a, int q, Compare cmp = Compare(), Projection proj = Projection())
+{
+	for (int c((q >> 1) - 1); c >= 0; --c)maxHeap(a, c, q, cmp, proj);
+}
+template<class T, class Compare = Less, class Projection = Identity>inline void heapSort(T* const a, int q, Compare cmp = Compare(), Projection proj = Projection())
+{
+	if (q < 2)return;
+	buildMaxHeap(a, q, cmp, proj);
+	for (int c(q - 1); c; --c)
+	{
+		std::swap(a[c], a[0]);
+		maxTopHeap(a, c, cmp, proj);
+	}
+}
+
+//insertionSort: sorts a[p, q), fast on short or nearly sorted ranges
+template<class T, class Compare = Less, class Projection = Identity>inline void insertionSort(T* const a, int p, int q, Compare cmp = Compare(), Projection proj = Projection())
+{
+	for (int c0(p + 1); c0 < q; ++c0)
+	{
+		if (!cmp(proj(a[c0]), proj(a[c0 - 1])))continue;
+		T t(std::move(a[c0]));
+		int c1(c0);
+		do
+		{
+			a[c1] = std::move(a[c1 - 1]);
+			--c1;
+		} while (c1 > p && cmp(proj(t), proj(a[c1 - 1])));
+		a[c1] = std::move(t);
+	}
+}
+//smallSort: base case of the quick sorts, with SIMD plain int, unsigned int and float
+//keys in ascending order go through a sorting network (so ranges up to SortingNetworkMax
+//are left to it) instead of insertionSort
+template<class T, class Compare, class Projection>struct UseSortingNetwork :
+	BoolConstant<SortingNetworkSimd && IsNetworkKey<T>::value && IsSameType<Compare, Less>::value && IsSameType<Projection, Identity>::value> {};
+template<class T, class Compare = Less, class Projection = Identity>inline void smallSort(T* const a, int p, int q, Compare cmp = Compare(), Projection proj = Projection())
+{
+	if constexpr (UseSortingNetwork<T, Compare, Projection>::value)
+		sortingNetwork(a + p, q - p);
+	else
+		insertionSort(a, p, q, cmp, proj);
+}
+//sortThree: orders a[x] <= a[y] <= a[z]
+template<class T, class Compare = Less, class Projection = Identity>inline void sortThree(T* const a, int x, int y, int z, Compare cmp = Compare(), Projection proj = Projection())
+{
+	if (cmp(proj(a[y]), proj(a[x])))std::swap(a[x], a[y]);
+	if (cmp(proj(a[z]), proj(a[y])))
+	{
+		std::swap(a[y], a[z]);
+		if (cmp(proj(a[y]), proj(a[x])))std::swap(a[x], a[y]);
+	}
+}
+
+//quickPartition: partitions a[p, q) around a median of three (ninther above 128
+//elements) pivot and returns its index j: a[p, j) <= a[j] <= a[j + 1, q)
+template<class T, class Compare = Less, class Projection = Identity>inline int quickPartition(T* const a, int p, int q, Compare cmp = Compare(), Projection proj = Projection())
+{
+	int m(p + ((q - p) >> 1));
+	if (q - p > 128)
+	{
+		int s((q - p) >> 3);
+		sortThree(a, p, p + s, p + 2 * s, cmp, proj);
+		sortThree(a, m - s, m, m + s, cmp, proj);
+		sortThree(a, q - 1 - 2 * s, q - 1 - s, q - 1, cmp, proj);
+		sortThree(a, p + s, m, q - 1 - s, cmp, proj);
+	}
+	else sortThree(a, p, m, q - 1, cmp, proj);
+	std::swap(a[p], a[m]);
+	//Hoare partition around a[p], stopping on equal keys keeps many equal keys balanced
+	int i(p), j(q);
+	{
+		auto&& pivot(proj(a[p]));
+		while (true)
 		{
-			T t(a[p]);
-			a[p] = a[r];
-			a[r] = t;
-			if ((r + 1) << 1 < q)
-				maxHeap(a, r, q);
+			while (++i < q && cmp(proj(a[i]), pivot));
+			while (cmp(pivot, proj(a[--j])));
+			if (i >= j)break;
+			std::swap(a[i], a[j]);
+		}
+	}
+	std::swap(a[p], a[j]);
+	return j;
+}
+//introSort: quick sort on a[p, q), recursing only into the smaller side so the stack
+//stays O(log n); once depth levels are used up the range goes to heapSort, short ranges
+//go to smallSort.
+static constexpr int IntroSortCutoff = 16;
+template<class T, class Compare = Less, class Projection = Identity>inline void introSort(T* const a, int p, int q, int depth, Compare cmp = Compare(), Projection proj = Projection())
+{
+	static constexpr int cutoff(UseSortingNetwork<T, Compare, Projection>::value ? SortingNetworkMax : IntroSortCutoff);
+	while (q - p > cutoff)
+	{
+		if (!depth--)
+		{
+			heapSort(a + p, q - p, cmp, proj);
+			return;
+		}
+		int j(quickPartition(a, p, q, cmp, proj));
+		if (j - p < q - j - 1)
+		{
+			introSort(a, p, j, depth, cmp, proj);
+			p = j + 1;
 		}
 		else
 		{
-			T t(a[p]);
-			a[p] = a[l];
-			a[l] = t;
-			if ((l << 1) + 1 < q)
-				maxHeap(a, l, q);
+			introSort(a, j + 1, q, depth, cmp, proj);
+			q = j;
 		}
 	}
-	else
+	smallSort(a, p, q, cmp, proj);
+}
+//qsort: sorts a[p, q)
+template<class T, class Compare = Less, class Projection = Identity>inline void qsort(T* const a, int p, int q, Compare cmp = Compare(), Projection proj = Projection())
+{
+	if (q - p < 2)return;
+	int depth(0);
+	for (int n(q - p); n > 1; n >>= 1)depth += 2;
+	introSort(a, p, q, depth, cmp, proj);
+}
+template<class T, class Growth, class Allocator, class Compare = Less, class Projection = Identity>inline void qsort(Vector<T, Growth, Allocator>& a, Compare cmp = Compare(), Projection proj = Projection())
+{
+	qsort(a.data, 0, a.length, cmp, proj);
+}
+
+//nthElement: puts in a[n] the element a sorted a[p, q) would have there, with a[p, n)
+//not greater and a[n + 1, q) not less than it. Introselect: quick select on the side
+//holding n, expected O(n); past 2log(n) partitions it falls back to a heap select.
+template<class T, class Compare = Less, class Projection = Identity>inline void nthElement(T* const a, int p, int n, int q, Compare cmp = Compare(), Projection proj = Projection())
+{
+	if (n < p || n >= q)return;
+	int depth(0);
+	for (int c(q - p); c > 1; c >>= 1)depth += 2;
+	static constexpr int cutoff(UseSortingNetwork<T, Compare, Projection>::value ? SortingNetworkMax : IntroSortCutoff);
+	while (q - p > cutoff)
 	{
-		if (r < q && a[p] < a[r])
+		if (!depth--)
 		{
-			T t(a[p]);
-			a[p] = a[r];
-			a[r] = t;
-			if ((r + 1) << 1 < q)
-				maxHeap(a, r, q);
+			//heap of the n - p + 1 smallest, its top is the answer
+			int k(n - p + 1);
+			buildMaxHeap(a + p, k, cmp, proj);
+			for (int c0(p + k); c0 < q; ++c0)
+				if (cmp(proj(a[c0]), proj(a[p])))
+				{
+					std::swap(a[c0], a[p]);
+					maxTopHeap(a + p, k, cmp, proj);
+				}
+			std::swap(a[p], a[n]);
+			return;
 		}
+		int j(quickPartition(a, p, q, cmp, proj));
+		if (j == n)return;
+		if (n < j)q = j;
+		else p = j + 1;
+	}
+	smallSort(a, p, q, cmp, proj);
+}
+template<class T, class Growth, class Allocator, class Compare = Less, class Projection = Identity>inline void nthElement(Vector<T, Growth, Allocator>& a, int n, Compare cmp = Compare(), Projection proj = Projection())
+{
+	nthElement(a.data, 0, n, a.length, cmp, proj);
+}
+//partialSort: sorts the m - p smallest elements of a[p, q) into a[p, m), the rest are
+//left in any order: O(n + k log k) with nthElement finding the boundary
+template<class T, class Compare = Less, class Projection = Identity>inline void partialSort(T* const a, int p, int m, int q, Compare cmp = Compare(), Projection proj = Projection())
+{
+	if (m <= p)return;
+	if (m < q)
+	{
+		nthElement(a, p, m - 1, q, cmp, proj);
+		--m;
 	}
+	qsort(a, p, m, cmp, proj);
+}
+template<class T, class Growth, class Allocator, class Compare = Less, class Projection = Identity>inline void partialSort(Vector<T, Growth, Allocator>& a, int m, Compare cmp = Compare(), Projection proj = Projection())
+{
+	partialSort(a.data, 0, m, a.length, cmp, proj);
+}
+//TopK: keeps the _k smallest elements pushed into it, without storing the stream.
+//They are held in a max heap, so the kept element that goes first is the top and a
+//push costs one compare unless the element makes it in (then O(log _k)).
+template<class T, unsigned int _k, class Compare = Less, class Projection = Identity>struct TopK
+{
+	static_assert(_k >= 1, "TopK needs to keep at least 1 element!");
+	alignas(T) unsigned char storage[_k * sizeof(T)];
+	unsigned int length;
+	Compare cmp;
+	Projection proj;
+
+	TopK(Compare const& = Compare(), Projection const& = Projection());
+	TopK(TopK const&);
+	~TopK();
+	TopK& operator=(TopK const&);
+
+	T* data();
+	T const* data()const;
+	bool full()const;
+	//worst: the largest kept element, anything not less than it is rejected once full
+	T const& worst()const;
+	TopK& push(T const&);
+	template<class R>TopK& push(R const*, int);
+	TopK& clear();
+	//result: the kept elements, sorted
+	Vector<T>result()const;
+};
+template<class T, unsigned int _k, class Compare, class Projection>inline TopK<T, _k, Compare, Projection>::TopK(Compare const& _cmp, Projection const& _proj)
+	:
+	length(0),
+	cmp(_cmp),
+	proj(_proj)
+{
+}
+template<class T, unsigned int _k, class Compare, class Projection>inline TopK<T, _k, Compare, Projection>::TopK(TopK const& a)
+	:
+	length(a.length),
+	cmp(a.cmp),
+	proj(a.proj)
+{
+	for (unsigned int c1 = 0; c1 < length; c1++)new(data() + c1)T(a.data()[c1]);
+}
+template<class T, unsigned int _k, class Compare, class Projection>inline TopK<T, _k, Compare, Projection>::~TopK()
+{
+	clear();
+}
+template<class T, unsigned int _k, class Compare, class Projection>inline TopK<T, _k, Compare, Projection>& TopK<T, _k, Compare, Projection>::operator=(TopK const& a)
+{
+	if (this == &a)return *this;
+	this->~TopK();
+	new(this)TopK(a);
+	return *this;
+}
+template<class T, unsigned int _k, class Compare, class Projection>inline T* TopK<T, _k, Compare, Projection>::data()
+{
+	return (T*)storage;
+}
+template<class T, unsigned int _k, class Compare, class Projection>inline T const* TopK<T, _k, Compare, Projection>::data()const
+{
+	return (T const*)storage;
+}
+template<class T, unsigned int _k, class Compare, class Projection>inline bool TopK<T, _k, Compare, Projection>::full()const
+{
+	return length == _k;
+}
+template<class T, unsigned int _k, class Compare, class Projection>inline T const& TopK<T, _k, Compare, Projection>::worst()const
+{
+	return data()[0];
 }
-template<class T>inline void maxTopHeap(T* const a, int q)
+template<class T, unsigned int _k, class Compare, class Projection>inline TopK<T, _k, Compare, Projection>& TopK<T, _k, Compare, Projection>::push(T const& a)
 {
-	if (1 < q && *a < a[1])
+	if (length < _k)
 	{
-		if (2 < q && a[1] < a[2])
+		new(data() + length)T(a);
+		maxHeapUp(data(), length++, cmp, proj);
+	}
+	else if (cmp(proj(a), proj(data()[0])))
+	{
+		data()[0] = a;
+		maxTopHeap(data(), _k, cmp, proj);
+	}
+	return *this;
+}
+template<class T, unsigned int _k, class Compare, class Projection>template<class R>inline TopK<T, _k, Compare, Projection>& TopK<T, _k, Compare, Projection>::push(R const* a, int n)
+{
+	for (int c1(0); c1 < n; ++c1)push(a[c1]);
+	return *this;
+}
+template<class T, unsigned int _k, class Compare, class Projection>inline TopK<T, _k, Compare, Projection>& TopK<T, _k, Compare, Projection>::clear()
+{
+	while (length)(data() + --length)->~T();
+	return *this;
+}
+template<class T, unsigned int _k, class Compare, class Projection>inline Vector<T>TopK<T, _k, Compare, Projection>::result()const
+{
+	Vector<T>r;
+	r.reserve(length);
+	for (unsigned int c1 = 0; c1 < length; c1++)r.pushBack(data()[c1]);
+	heapSort(r.data, r.length, cmp, proj);
+	return r;
+}
+
+//mergeRuns: stable merge of x[0, nx) and y[0, ny) into r, takes from y only when it is strictly smaller
+template<class T, class Compare = Less, class Projection = Identity>inline void mergeRuns(T* x, int nx, T* y, int ny, T* r, Compare cmp = Compare(), Projection proj = Projection())
+{
+	T* xe(x + nx);
+	T* ye(y + ny);
+	while (x != xe && y != ye)
+		*r++ = std::move(cmp(proj(*y), proj(*x)) ? *y++ : *x++);
+	while (x != xe)*r++ = std::move(*x++);
+	while (y != ye)*r++ = std::move(*y++);
+}
+//stableSortRange: stable sort of a[0, n) with b[0, n) as scratch: insertion sorted runs
+//of StableSortRun elements, then bottom up merges going back and forth between a and b
+static constexpr int StableSortRun = 32;
+template<class T, class Compare = Less, class Projection = Identity>inline void stableSortRange(T* const a, T* const b, int n, Compare cmp = Compare(), Projection proj = Projection())
+{
+	for (int c0(0); c0 < n; c0 += StableSortRun)
+		insertionSort(a, c0, c0 + StableSortRun < n ? c0 + StableSortRun : n, cmp, proj);
+	T* src(a);
+	T* dst(b);
+	for (int w(StableSortRun); w < n; w <<= 1)
+	{
+		for (int c0(0); c0 < n; c0 += w << 1)
 		{
-			T t(*a);
-			*a = a[2];
-			a[2] = t;
-			if (5 < q)
-				maxHeap(a, 2, q);
+			int m(c0 + w < n ? c0 + w : n);
+			int e(c0 + (w << 1) < n ? c0 + (w << 1) : n);
+			mergeRuns(src + c0, m - c0, src + m, e - m, dst + c0, cmp, proj);
 		}
-		else
+		std::swap(src, dst);
+	}
+	if (src != a)
+		for (int c0(0); c0 < n; ++c0)a[c0] = std::move(src[c0]);
+}
+//SortAllocator: default allocator of the sorts' scratch buffers, cache line aligned.
+//stableSort, parallelSort and radixSort take another one as their last argument, e.g.
+//CountingAllocator<SortAllocator>() to count them.
+using SortAllocator = AlignedAllocator<64>;
+//scratch for the merge sorts: n elements built from a, so only assignments follow
+template<class Scratch, class T>inline T* sortScratch(T* const a, int n)
+{
+	static_assert(alignof(T) <= 64, "Sort scratch is aligned to 64!");
+	T* r((T*)Scratch::allocate(n * sizeof(T)));
+	if constexpr (!__is_trivially_copyable(T))
+		for (int c0(0); c0 < n; ++c0)
 		{
-			T t(*a);
-			*a = a[1];
-			a[1] = t;
-			if (3 < q)
-				maxHeap(a, 1, q);
+			new(r + c0)T(std::move(a[c0]));
+			a[c0] = std::move(r[c0]);
 		}
+	return r;
+}
+template<class Scratch, class T>inline void freeSortScratch(T* a, int n)
+{
+	if constexpr (!__is_trivially_copyable(T))
+		for (int c0(0); c0 < n; ++c0)(a + c0)->~T();
+	Scratch::deallocate(a, n * sizeof(T));
+}
+//stableSort: sorts a[p, q) keeping the order of equal elements
+template<class T, class Compare = Less, class Projection = Identity, class Scratch = SortAllocator>inline void stableSort(T* const a, int p, int q, Compare cmp = Compare(), Projection proj = Projection(), Scratch = Scratch())
+{
+	if (q - p < 2)return;
+	if (q - p <= StableSortRun)
+	{
+		insertionSort(a, p, q, cmp, proj);
+		return;
+	}
+	T* b(sortScratch<Scratch>(a + p, q - p));
+	stableSortRange(a + p, b, q - p, cmp, proj);
+	freeSortScratch<Scratch>(b, q - p);
+}
+template<class T, class Growth, class Allocator, class Compare = Less, class Projection = Identity, class Scratch = SortAllocator>inline void stableSort(Vector<T, Growth, Allocator>& a, Compare cmp = Compare(), Projection proj = Projection(), Scratch scratch = Scratch())
+{
+	stableSort(a.data, 0, a.length, cmp, proj, scratch);
+}
+
+//Parallel merge sort: ranges above grain elements are halved between threads, the
+//halves are merged by splitting the merge itself at a binary searched point.
+//It is stable, so the result is the same for every thread count and grain.
+static constexpr int ParallelSortGrain = 1 << 14;
+//parallelMerge: mergeRuns split over threads
+template<class T, class Compare = Less, class Projection = Identity>inline void parallelMerge(T* x, int nx, T* y, int ny, T* r, unsigned int threads, int grain, Compare cmp = Compare(), Projection proj = Projection())
+{
+	if (threads < 2 || nx + ny <= grain)
+	{
+		mergeRuns(x, nx, y, ny, r, cmp, proj);
+		return;
+	}
+	int mx, my;
+	if (nx >= ny)
+	{
+		//y before x[mx] only if strictly smaller
+		mx = nx >> 1;
+		int l(0), h(ny);
+		while (l < h)
+		{
+			int m((l + h) >> 1);
+			if (cmp(proj(y[m]), proj(x[mx])))l = m + 1;
+			else h = m;
+		}
+		my = l;
 	}
 	else
 	{
-		if (2 < q && *a < a[2])
+		//x before y[my] if not greater
+		my = ny >> 1;
+		int l(0), h(nx);
+		while (l < h)
 		{
-			T t(*a);
-			*a = a[2];
-			a[2] = t;
-			if (5 < q)
-				maxHeap(a, 2, q);
+			int m((l + h) >> 1);
+			if (!cmp(proj(y[my]), proj(x[m])))l = m + 1;
+			else h = m;
 		}
+		mx = l;
 	}
+	std::thread t([=]() { parallelMerge(x, mx, y, my, r, threads >> 1, grain, cmp, proj); });
+	parallelMerge(x + mx, nx - mx, y + my, ny - my, r + mx + my, threads - (threads >> 1), grain, cmp, proj);
+	t.join();
 }
-template<class T>inline void buildMaxHeap(T* const a, int q)
+template<class T>inline void parallelMove(T* a, T* b, int n, unsigned int threads, int grain)
 {
-	for (int c((q >> 1) - 1); c; --c)maxHeap(a, c, q);
-	maxTopHeap(a, q);
+	if (threads < 2 || n <= grain)
+	{
+		for (int c0(0); c0 < n; ++c0)b[c0] = std::move(a[c0]);
+		return;
+	}
+	int h(n >> 1);
+	std::thread t([=]() { parallelMove(a, b, h, threads >> 1, grain); });
+	parallelMove(a + h, b + h, n - h, threads - (threads >> 1), grain);
+	t.join();
 }
-template<class T>inline void heapSort(T* const a, int q)
+template<class T, class Compare = Less, class Projection = Identity>inline void parallelSortRange(T* const a, T* const b, int n, unsigned int threads, int grain, Compare cmp = Compare(), Projection proj = Projection())
 {
-	for (int c((q >> 1) - 1); c; --c)maxHeap(a, c, q);
-	maxTopHeap(a, q);
-	for (int c(q - 1); c; --c)
+	if (threads < 2 || n <= grain)
 	{
-		T t(a[c]);
-		a[c] = a[0];
-		a[0] = t;
-		maxTopHeap(a, c);
+		stableSortRange(a, b, n, cmp, proj);
+		return;
 	}
+	int h(n >> 1);
+	std::thread t([=]() { parallelSortRange(a, b, h, threads >> 1, grain, cmp, proj); });
+	parallelSortRange(a + h, b + h, n - h, threads - (threads >> 1), grain, cmp, proj);
+	t.join();
+	parallelMerge(a, h, a + h, n - h, b, threads, grain, cmp, proj);
+	parallelMove(b, a, n, threads, grain);
+}
+//parallelSort: sorts a[p, q) with threads threads (0: all cores), grain is the
+//smallest range worth a thread
+template<class T, class Compare = Less, class Projection = Identity, class Scratch = SortAllocator>inline void parallelSort(T* const a, int p, int q, unsigned int threads = 0, int grain = ParallelSortGrain, Compare cmp = Compare(), Projection proj = Projection(), Scratch scratch = Scratch())
+{
+	if (!threads)threads = std::thread::hardware_concurrency();
+	if (grain < StableSortRun)grain = StableSortRun;
+	if (threads < 2 || q - p <= grain)
+	{
+		stableSort(a, p, q, cmp, proj, scratch);
+		return;
+	}
+	T* b(sortScratch<Scratch>(a + p, q - p));
+	parallelSortRange(a + p, b, q - p, threads, grain, cmp, proj);
+	freeSortScratch<Scratch>(b, q - p);
+}
+template<class T, class Growth, class Allocator, class Compare = Less, class Projection = Identity, class Scratch = SortAllocator>inline void parallelSort(Vector<T, Growth, Allocator>& a, unsigned int threads = 0, int grain = ParallelSortGrain, Compare cmp = Compare(), Projection proj = Projection(), Scratch scratch = Scratch())
+{
+	parallelSort(a.data, 0, a.length, threads, grain, cmp, proj, scratch);
 }
 
-
-template<class T>inline void qsort(T* const a, int p, int q)
+//LSD radix sort for integers and IEEE floats, one byte per pass, going back and forth
+//between a and a scratch buffer. Passes where every key has the same byte are skipped,
+//so keys using only their low bytes (cell indices, small ids) take fewer passes.
+//Keys are mapped to unsigned bits keeping their order: the sign bit of signed integers
+//is flipped, negative floats have all bits flipped, positive floats only the sign bit.
+template<unsigned int _size>struct RadixBits;
+template<>struct RadixBits<1> { using type = unsigned char; };
+template<>struct RadixBits<2> { using type = unsigned short; };
+template<>struct RadixBits<4> { using type = unsigned int; };
+template<>struct RadixBits<8> { using type = unsigned long long; };
+template<class T>struct RadixKey
 {
-	if (p < q - 1)
+	static_assert(std::is_arithmetic<T>::value, "radixSort needs integer or floating point keys!");
+	using Bits = typename RadixBits<sizeof(T)>::type;
+	static constexpr Bits sign = Bits(1) << (sizeof(T) * 8 - 1);
+
+	static Bits bits(T a)
 	{
-		T& k(a[q - 1]);
-		int m(p), n(q - 2);
-		while (1)
+		Bits r;
+		::memcpy(&r, &a, sizeof(T));
+		if constexpr (std::is_floating_point<T>::value)return (r & sign) ? Bits(~r) : Bits(r | sign);
+		else if constexpr (std::is_signed<T>::value)return r ^ sign;
+		else return r;
+	}
+	static unsigned int digit(T a, unsigned int pass)
+	{
+		return (unsigned int)(bits(a) >> (pass << 3)) & 255;
+	}
+};
+//runThreads: f(c0) for c0 in [0, threads), c0 = 0 on the calling thread
+template<class F>inline void runThreads(unsigned int threads, F&& f)
+{
+	Vector<std::thread>t;
+	t.reserve(threads);
+	for (unsigned int c0(1); c0 < threads; ++c0)t.emplaceBack(f, c0);
+	f(0u);
+	for (int c0(0); c0 < t.length; ++c0)t[c0].join();
+}
+//radixSortKeys: sorts keys[0, n) and moves values (if not nullptr) the same way
+template<class Scratch, class K, class V>inline void radixSortKeys(K* keys, V* values, int n, unsigned int threads)
+{
+	static_assert(__is_trivially_copyable(K) && __is_trivially_copyable(V), "radixSort moves keys and values with memcpy!");
+	constexpr unsigned int passes(sizeof(K));
+	using Count = unsigned int[passes][256];
+	if (n < 2)return;
+	if (!threads)threads = std::thread::hardware_concurrency();
+	if (threads > (unsigned int)(n >> 16))threads = (n >> 16) ? n >> 16 : 1;
+	//histograms of every pass at once, the bytes of a pass do not depend on the order
+	Count* counts((Count*)Scratch::allocate(threads * sizeof(Count)));
+	::memset(counts, 0, threads * sizeof(Count));
+	runThreads(threads, [&](unsigned int c0)
 		{
-			while (m < q - 1 && a[m] < k)++m;
-			while (n >= p && !(a[n] < k))--n;
-			if (n > m)
+			int b((int)((long long)n * c0 / threads)), e((int)((long long)n * (c0 + 1) / threads));
+			for (int c1(b); c1 < e; ++c1)
 			{
-				T t(a[m]);
-				a[m] = a[n];
-				a[n] = t;
+				typename RadixKey<K>::Bits t(RadixKey<K>::bits(keys[c1]));
+				for (unsigned int c2(0); c2 < passes; ++c2)
+					++counts[c0][c2][(t >> (c2 << 3)) & 255];
 			}
-			else break;
-		}
-		if (p < m)qsort(a, p, m);
-		T t(a[m]);
-		a[m] = k;
-		k = t;
-		qsort(a, m + 1, q);
+		});
+	Count total = {};
+	for (unsigned int c0(0); c0 < threads; ++c0)
+		for (unsigned int c1(0); c1 < passes; ++c1)
+			for (unsigned int c2(0); c2 < 256; ++c2)
+				total[c1][c2] += counts[c0][c1][c2];
+	K* keyBuffer((K*)Scratch::allocate(n * sizeof(K)));
+	V* valueBuffer(values ? (V*)Scratch::allocate(n * sizeof(V)) : nullptr);
+	K* ks(keys), * kd(keyBuffer);
+	V* vs(values), * vd(valueBuffer);
+	unsigned int(*offsets)[256]((unsigned int(*)[256])Scratch::allocate(threads * sizeof(unsigned int[256])));
+	for (unsigned int c1(0); c1 < passes; ++c1)
+	{
+		if (total[c1][RadixKey<K>::digit(ks[0], c1)] == (unsigned int)n)continue;
+		//each thread scatters its own chunk, chunks keep their order inside a bucket
+		if (threads > 1)
+			runThreads(threads, [&](unsigned int c0)
+				{
+					unsigned int* h(offsets[c0]);
+					::memset(h, 0, sizeof(unsigned int[256]));
+					int b((int)((long long)n * c0 / threads)), e((int)((long long)n * (c0 + 1) / threads));
+					for (int c2(b); c2 < e; ++c2)++h[RadixKey<K>::digit(ks[c2], c1)];
+				});
+		else ::memcpy(offsets[0], total[c1], sizeof(unsigned int[256]));
+		unsigned int sum(0);
+		for (unsigned int c2(0); c2 < 256; ++c2)
+			for (unsigned int c0(0); c0 < threads; ++c0)
+			{
+				unsigned int t(offsets[c0][c2]);
+				offsets[c0][c2] = sum;
+				sum += t;
+			}
+		runThreads(threads, [&](unsigned int c0)
+			{
+				unsigned int* h(offsets[c0]);
+				int b((int)((long long)n * c0 / threads)), e((int)((long long)n * (c0 + 1) / threads));
+				for (int c2(b); c2 < e; ++c2)
+				{
+					unsigned int d(h[RadixKey<K>::digit(ks[c2], c1)]++);
+					kd[d] = ks[c2];
+					if (values)vd[d] = vs[c2];
+				}
+			});
+		std::swap(ks, kd);
+		std::swap(vs, vd);
+	}
+	if (ks != keys)
+	{
+		::memcpy(keys, ks, n * sizeof(K));
+		if (values)::memcpy(values, vs, n * sizeof(V));
+	}
+	Scratch::deallocate(offsets, threads * sizeof(unsigned int[256]));
+	Scratch::deallocate(counts, threads * sizeof(Count));
+	Scratch::deallocate(keyBuffer, n * sizeof(K));
+	Scratch::deallocate(valueBuffer, n * sizeof(V));
+}
+//radixSort: sorts a[p, q), threads 0 means all cores (only used above 64K keys per thread)
+template<class T, class Scratch = SortAllocator>inline void radixSort(T* const a, int p, int q, unsigned int threads = 1, Scratch = Scratch())
+{
+	radixSortKeys<Scratch>(a + p, (unsigned int*)nullptr, q - p, threads);
+}
+//radixSort: sorts keys[p, q) and moves values[p, q) with them, e.g. indices of records
+template<class K, class V, class Scratch = SortAllocator>inline void radixSort(K* const keys, V* const values, int p, int q, unsigned int threads = 1, Scratch = Scratch())
+{
+	radixSortKeys<Scratch>(keys + p, values + p, q - p, threads);
+}
+template<class T, class Growth, class Allocator, class Scratch = SortAllocator>inline void radixSort(Vector<T, Growth, Allocator>& a, unsigned int threads = 1, Scratch scratch = Scratch())
+{
+	radixSort(a.data, 0, a.length, threads, scratch);
+}
+
+//prefetchRead: hint that a is about to be read
+inline void prefetchRead(void const* a)
+{
+#ifdef _MSC_VER
+	_mm_prefetch((char const*)a, _MM_HINT_T0);
+#else
+	__builtin_prefetch(a);
+#endif
+}
+
+//Binary search on a sorted a[p, q) with the usual comparator and projection (key is
+//compared to proj(a[n])). The loop halves the range with a conditional move instead of
+//a branch, so it runs the same log2(n) steps for every key and the CPU never guesses
+//wrong. Past the caches every probe is a miss, EytzingerArray is faster there.
+//lowerBound: first n in [p, q) with !(a[n] < key), q if there is none
+template<class T, class K, class Compare = Less, class Projection = Identity>inline int lowerBound(T const* const a, int p, int q, K const& key, Compare cmp = Compare(), Projection proj = Projection())
+{
+	int n(q - p);
+	if (n <= 0)return p;
+	T const* base(a + p);
+	while (n > 1)
+	{
+		int half(n >> 1);
+		base = cmp(proj(base[half]), key) ? base + half : base;
+		n -= half;
 	}
+	return int(base - a) + cmp(proj(*base), key);
+}
+//upperBound: first n in [p, q) with key < a[n], q if there is none
+template<class T, class K, class Compare = Less, class Projection = Identity>inline int upperBound(T const* const a, int p, int q, K const& key, Compare cmp = Compare(), Projection proj = Projection())
+{
+	int n(q - p);
+	if (n <= 0)return p;
+	T const* base(a + p);
+	while (n > 1)
+	{
+		int half(n >> 1);
+		base = cmp(key, proj(base[half])) ? base : base + half;
+		n -= half;
+	}
+	return int(base - a) + !cmp(key, proj(*base));
+}
+//equalRange: [lowerBound, upperBound) of key
+template<class T, class K, class Compare = Less, class Projection = Identity>inline Pair<int, int>equalRange(T const* const a, int p, int q, K const& key, Compare cmp = Compare(), Projection proj = Projection())
+{
+	int l(lowerBound(a, p, q, key, cmp, proj));
+	return Pair<int, int>(l, upperBound(a, l, q, key, cmp, proj));
+}
+template<class T, class Growth, class Allocator, class K, class Compare = Less, class Projection = Identity>inline int lowerBound(Vector<T, Growth, Allocator>const& a, K const& key, Compare cmp = Compare(), Projection proj = Projection())
+{
+	return lowerBound(a.data, 0, a.length, key, cmp, proj);
+}
+template<class T, class Growth, class Allocator, class K, class Compare = Less, class Projection = Identity>inline int upperBound(Vector<T, Growth, Allocator>const& a, K const& key, Compare cmp = Compare(), Projection proj = Projection())
+{
+	return upperBound(a.data, 0, a.length, key, cmp, proj);
+}
+template<class T, class Growth, class Allocator, class K, class Compare = Less, class Projection = Identity>inline Pair<int, int>equalRange(Vector<T, Growth, Allocator>const& a, K const& key, Compare cmp = Compare(), Projection proj = Projection())
+{
+	return equalRange(a.data, 0, a.length, key, cmp, proj);
 }
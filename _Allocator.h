@@ -0,0 +1,135 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+//Allocator policies used by Vector, List and String.
+//An allocator is a type with three static functions:
+//	void* allocate(size_t size);
+//	void* reallocate(void* ptr, size_t sizeOld, size_t size);	//keeps the first min(sizeOld, size) bytes, ptr may be nullptr
+//	void deallocate(void* ptr, size_t size);					//size is what the container asked for, ptr may be nullptr
+//State (arenas, pools...) lives in static members, so a container stays as small as before
+//and memory of one allocator type can be moved between containers using it.
+struct DefaultAllocator
+{
+	static void* allocate(size_t _size)
+	{
+		return ::malloc(_size);
+	}
+	static void* reallocate(void* _ptr, size_t, size_t _size)
+	{
+		return ::realloc(_ptr, _size);
+	}
+	static void deallocate(void* _ptr, size_t)
+	{
+		::free(_ptr);
+	}
+};
+
+//Every block starts on a multiple of _alignment (16/32 for SSE/AVX loads, 64 for a cache line,
+//PageAlignment for GPU staging and mapping). Growth and copies go through allocate, so the
+//alignment is kept for the whole life of the container.
+static constexpr size_t PageAlignment = 4096;
+template<size_t _alignment>struct AlignedAllocator
+{
+	static_assert(_alignment && !(_alignment & (_alignment - 1)), "Alignment must be a power of 2!");
+	static constexpr size_t alignment = _alignment < sizeof(void*) ? sizeof(void*) : _alignment;
+
+	static void* allocate(size_t _size)
+	{
+#ifdef _WIN32
+		return ::_aligned_malloc(_size, alignment);
+#else
+		void* r;
+		if (::posix_memalign(&r, alignment, _size))return nullptr;
+		return r;
+#endif
+	}
+	static void* reallocate(void* _ptr, size_t _sizeOld, size_t _size)
+	{
+#ifdef _WIN32
+		return ::_aligned_realloc(_ptr, _size, alignment);
+#else
+		//realloc may return a block with a weaker alignment, so move it by hand
+		void* r(allocate(_size));
+		if (!r)return nullptr;
+		if (_ptr)::memcpy(r, _ptr, _sizeOld < _size ? _sizeOld : _size);
+		::free(_ptr);
+		return r;
+#endif
+	}
+	static void deallocate(void* _ptr, size_t)
+	{
+#ifdef _WIN32
+		::_aligned_free(_ptr);
+#else
+		::free(_ptr);
+#endif
+	}
+};
+
+//AllocatorFor: what a container uses for elements aligned to _alignment. malloc only
+//guarantees alignof(std::max_align_t), so elements above it (alignas(32) vec4<double>...)
+//get an AlignedAllocator in place of the DefaultAllocator.
+template<class Allocator, size_t _alignment, bool _over = (_alignment > alignof(std::max_align_t))>struct AllocatorFor
+{
+	using Result = Allocator;
+};
+template<size_t _alignment>struct AllocatorFor<DefaultAllocator, _alignment, true>
+{
+	using Result = AlignedAllocator<_alignment>;
+};
+//ElementAllocator: Allocator for blocks of T, alignof(T) is only looked at when memory is
+//asked for, so containers can still be declared with an incomplete T (a File holding Files)
+template<class Allocator, class T>struct ElementAllocator
+{
+	static void* allocate(size_t _size)
+	{
+		return AllocatorFor<Allocator, alignof(T)>::Result::allocate(_size);
+	}
+	static void* reallocate(void* _ptr, size_t _sizeOld, size_t _size)
+	{
+		return AllocatorFor<Allocator, alignof(T)>::Result::reallocate(_ptr, _sizeOld, _size);
+	}
+	static void deallocate(void* _ptr, size_t _size)
+	{
+		AllocatorFor<Allocator, alignof(T)>::Result::deallocate(_ptr, _size);
+	}
+};
+
+//Counts the calls and the requested bytes going to Base, all containers using the
+//same CountingAllocator<Base> share the counters...
+template<class Base = DefaultAllocator>struct CountingAllocator
+{
+	static inline unsigned long long allocations = 0;
+	static inline unsigned long long reallocations = 0;
+	static inline unsigned long long deallocations = 0;
+	static inline unsigned long long bytes = 0;
+
+	static void* allocate(size_t _size)
+	{
+		++allocations;
+		bytes += _size;
+		return Base::allocate(_size);
+	}
+	static void* reallocate(void* _ptr, size_t _sizeOld, size_t _size)
+	{
+		++reallocations;
+		bytes += _size;
+		return Base::reallocate(_ptr, _sizeOld, _size);
+	}
+	static void deallocate(void* _ptr, size_t _size)
+	{
+		if (!_ptr)return;
+		++deallocations;
+		Base::deallocate(_ptr, _size);
+	}
+	static void reset()
+	{
+		allocations = reallocations = deallocations = 0;
+		bytes = 0;
+	}
+};
@@ -38,10 +38,13 @@ template<class T, unsigned int _length>struct Array
 	T& findFirst(T const&);
 	T& findFirst(bool(*cmp)(const T&, const T&), T const&);
 	T& findFirst(bool(*cmp)(const T&, const T&), T&&);
+	template<class F>T& findFirst(F&&, T const&);
 	Vector<T*> find(T const&);
 	//traverse
 	bool traverse(bool(*p)(T&));
 	bool traverse(bool(*p)(T const&))const;
+	template<class F>bool traverse(F&&);
+	template<class F>bool traverse(F&&)const;
 	//printInfo
 	void printInfo()const;
 };
@@ -174,6 +177,12 @@ template<class T, unsigned int _length>inline T & Array<T, _length>::findFirst(b
 		if (cmp(a, d))return d;
 	return *(T*)nullptr;
 }
+template<class T, unsigned int _length>template<class F>inline T& Array<T, _length>::findFirst(F&& cmp, T const& a)
+{
+	for (T& d : data)
+		if (cmp(a, (T const&)d))return d;
+	return *(T*)nullptr;
+}
 template<class T, unsigned int _length>inline Vector<T*> Array<T, _length>::find(T const& a)
 {
 	Vector<T*>r;
@@ -195,6 +204,18 @@ template<class T, unsigned int _length>inline bool Array<T, _length>::traverse(b
 		if (!p(d))return false;
 	return true;
 }
+template<class T, unsigned int _length>template<class F>inline bool Array<T, _length>::traverse(F&& p)
+{
+	for (T& d : data)
+		if (!p(d))return false;
+	return true;
+}
+template<class T, unsigned int _length>template<class F>inline bool Array<T, _length>::traverse(F&& p) const
+{
+	for (T const& d : data)
+		if (!p(d))return false;
+	return true;
+}
 //printInfo
 template<class T, unsigned int _length>inline void Array<T, _length>::printInfo() const
 {
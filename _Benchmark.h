@@ -0,0 +1,683 @@
+#pragma once
+#include <cstdio>
+#include <cstring>
+#include <_Vector.h>
+#include <_Algorithm.h>
+#include <_EytzingerArray.h>
+#include <_PriorityQueue.h>
+#include <_List.h>
+#include <_UnrolledList.h>
+#include <_Time.h>
+
+//Benchmark of the sorts and searches of _Algorithm.h over the standard input
+//distributions and element types, one CSV row per algorithm, type and distribution:
+//	algorithm,type,distribution,n,ns_per_element,comparisons,allocations,bytes,ok
+//ns_per_element is the best of repeats runs timed with Timer. comparisons come from one
+//more run through a counting comparator (so small ranges take insertionSort there even
+//where the timed run uses a sorting network, and radixSort reports 0). allocations and
+//bytes are the sort scratch, the sorts are given BenchmarkAllocator to count it. ok is 0
+//if the output is wrong.
+//Keys are below 2^24 so that float keys stay exact.
+//The other run functions write tables of their own, BenchmarkTables names all of them and
+//run(path) writes each into its own path<name>.csv. Benchmark.cpp is the program.
+enum class Distribution
+{
+	Random,
+	Sorted,
+	Reverse,
+	FewUnique,
+	OrganPipe,
+	Zipf,
+};
+static constexpr char const* DistributionNames[]{ "random", "sorted", "reverse", "few_unique", "organ_pipe", "zipf" };
+static constexpr int DistributionCount = 6;
+
+//Record64: a cache line sized record sorted by key, the payload is moved along
+struct Record64
+{
+	unsigned int key;
+	unsigned int payload[15];
+};
+
+//BenchmarkVec4: 16 byte aligned 4 floats like Math::vec4<float>, sorted by data[0]
+struct alignas(16) BenchmarkVec4
+{
+	float data[4];
+};
+
+//BenchmarkAllocator: sort scratch allocator that counts what the sorts take
+using BenchmarkAllocator = CountingAllocator<SortAllocator>;
+
+//BenchmarkElement: element with key a, and the projection to its key
+template<class T>struct BenchmarkElement;
+template<>struct BenchmarkElement<int>
+{
+	using Key = Identity;
+	static constexpr char const* name = "int";
+	static int make(unsigned int a) { return int(a); }
+};
+template<>struct BenchmarkElement<float>
+{
+	using Key = Identity;
+	static constexpr char const* name = "float";
+	static float make(unsigned int a) { return float(a); }
+};
+template<>struct BenchmarkElement<BenchmarkVec4>
+{
+	struct Key
+	{
+		float operator()(BenchmarkVec4 const& a)const { return a.data[0]; }
+	};
+	static constexpr char const* name = "vec4_float";
+	static BenchmarkVec4 make(unsigned int a)
+	{
+		BenchmarkVec4 r;
+		r.data[0] = float(a);
+		r.data[1] = r.data[2] = r.data[3] = 1.0f;
+		return r;
+	}
+};
+template<>struct BenchmarkElement<Record64>
+{
+	struct Key
+	{
+		unsigned int operator()(Record64 const& a)const { return a.key; }
+	};
+	static constexpr char const* name = "record64";
+	static Record64 make(unsigned int a)
+	{
+		Record64 r;
+		r.key = a;
+		for (unsigned int c0(0); c0 < 15; ++c0)r.payload[c0] = a + c0;
+		return r;
+	}
+};
+
+//CountingCompare: Compare that counts its calls
+template<class Compare = Less>struct CountingCompare
+{
+	Compare cmp;
+	unsigned long long* count;
+
+	template<class A, class B>bool operator()(A const& a, B const& b)const
+	{
+		++*count;
+		return cmp(a, b);
+	}
+};
+
+//HeapOrder: PriorityQueue Compare that puts the smallest key on top, so popping sorts
+template<class Compare, class Projection>struct HeapOrder
+{
+	Compare cmp;
+	Projection proj;
+
+	template<class T>bool operator()(T const& a, T const& b)const
+	{
+		return cmp(proj(b), proj(a));
+	}
+};
+
+//branchyLowerBound: the textbook binary search, branching on every comparison
+inline int branchyLowerBound(int const* a, int p, int q, int key)
+{
+	while (p < q)
+	{
+		int m(p + (q - p) / 2);
+		if (a[m] < key)p = m + 1;
+		else q = m;
+	}
+	return p;
+}
+
+//the same int comparison and visit as a function, for calls through a function pointer,
+//and as a functor
+inline bool lessFunction(int const& a, int const& b)
+{
+	return a < b;
+}
+inline bool equalFunction(int const& a, int const& b)
+{
+	return a == b;
+}
+inline bool incrementFunction(int& a)
+{
+	++a;
+	return true;
+}
+struct LessFunctor
+{
+	bool operator()(int const& a, int const& b)const { return a < b; }
+};
+
+//BenchmarkRandom: xorshift64*, the same inputs on every platform
+struct BenchmarkRandom
+{
+	unsigned long long state;
+
+	BenchmarkRandom(unsigned long long);
+	unsigned int next();
+	double uniform();
+};
+
+struct Benchmark
+{
+	int n;
+	int repeats;
+	unsigned int threads;
+	FILE* out;
+
+	Benchmark(int = 1 << 20, int = 3, FILE* = stdout, unsigned int = 0);
+
+	//run: every table, or the one named, into path<name>.csv, false if there is no such
+	//table or its file could not be opened
+	bool run(char const*);
+	bool run(char const*, char const*);
+	//runSorts: the table above, runType for every element type
+	void runSorts();
+	template<class T>void runType();
+	//runThreads: parallelSort of n random ints at 1 to 16 threads against qsort. On a one
+	//core host (n = 2^20, g++ 12 -O2 -march=native, three runs) it only shows the cost of
+	//the threads: speedup 0.81-0.84 at 1 thread, 0.67-0.79 at 16
+	void runThreads();
+	//runSearch: n lookups in L1, L2 and DRAM sized sorted int tables by Vector::posFirst,
+	//branchyLowerBound, lowerBound and EytzingerArray. ns per query with g++ 12 -O2
+	//-march=native, three runs: 16 KB: 123-129 branchy, 25-28 lowerBound, 27-30 eytzinger.
+	//256 KB: 150-196, 45-59, 33-46. 64 MB: 900-997, 898-944, 251-267
+	void runSearch();
+	//runComparators: qsort, Vector::traverse and Vector::findFirst over 10M ints given a
+	//function pointer and given a functor. g++ 12 -O2 -march=native, three runs: qsort
+	//149-156 ns per element with a functor against 185-228 through a function pointer,
+	//traverse and findFirst 0.91-0.96 either way (the pointer is to a known function and
+	//gets inlined too)
+	void runComparators();
+	//runLists: n pushBack and popBack on List with its NodePool and with a PerNodeAllocator
+	void runLists();
+	//runMixed: inserts at random positions mixed with full scans on UnrolledList, List and
+	//Vector holding at least 2^20 ints
+	void runMixed();
+	//keys: n keys of the distribution a
+	Vector<unsigned int>keys(Distribution)const;
+	//measure: sort(T*, int, cmp) on copies of input, check(T const*) on the result
+	template<class T, class F, class C>void measure(char const*, Distribution, Vector<T>const&, F&&, C&&);
+	//measureSearch: search(key, cmp) for the key of every query
+	template<class T, class F, class C>void measureSearch(char const*, Distribution, Vector<T>const&, F&&, C&&);
+	template<class T>void printRow(char const*, Distribution, double, unsigned long long, unsigned long long, unsigned long long, bool);
+	//best: best time in nanoseconds of sort(T*, int) on repeats copies of input, the last
+	//result is left in r
+	template<class T, class F>long long best(Vector<T>const&, F&&, Vector<T>& r);
+	//best: best time in nanoseconds of repeats calls of f()
+	template<class F>long long best(F&&);
+};
+
+//BenchmarkTable: a table of the suite and the function writing it to Benchmark::out
+struct BenchmarkTable
+{
+	char const* name;
+	void (Benchmark::* run)();
+};
+static constexpr BenchmarkTable BenchmarkTables[]
+{
+	{ "sorts", &Benchmark::runSorts },
+	{ "threads", &Benchmark::runThreads },
+	{ "search", &Benchmark::runSearch },
+	{ "comparators", &Benchmark::runComparators },
+	{ "lists", &Benchmark::runLists },
+	{ "mixed", &Benchmark::runMixed },
+};
+static constexpr int BenchmarkTableCount = sizeof(BenchmarkTables) / sizeof(*BenchmarkTables);
+
+//BenchmarkRandom
+inline BenchmarkRandom::BenchmarkRandom(unsigned long long _seed)
+	:
+	state(_seed ? _seed : 0x9E3779B97F4A7C15ull)
+{
+}
+inline unsigned int BenchmarkRandom::next()
+{
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+	return (unsigned int)((state * 0x2545F4914F6CDD1Dull) >> 32);
+}
+inline double BenchmarkRandom::uniform()
+{
+	return next() * (1.0 / 4294967296.0);
+}
+
+//Benchmark
+inline Benchmark::Benchmark(int _n, int _repeats, FILE* _out, unsigned int _threads)
+	:
+	n(_n),
+	repeats(_repeats),
+	threads(_threads),
+	out(_out)
+{
+}
+inline bool Benchmark::run(char const* _path)
+{
+	for (int c0(0); c0 < BenchmarkTableCount; ++c0)
+		if (!run(_path, BenchmarkTables[c0].name))return false;
+	return true;
+}
+inline bool Benchmark::run(char const* _path, char const* _table)
+{
+	for (int c0(0); c0 < BenchmarkTableCount; ++c0)
+		if (!::strcmp(BenchmarkTables[c0].name, _table))
+		{
+			char name[1024];
+			::snprintf(name, sizeof(name), "%s%s.csv", _path, _table);
+			FILE* file(::fopen(name, "w"));
+			if (!file)return false;
+			FILE* t(out);
+			out = file;
+			(this->*BenchmarkTables[c0].run)();
+			out = t;
+			::fclose(file);
+			return true;
+		}
+	return false;
+}
+inline void Benchmark::runSorts()
+{
+	::fprintf(out, "algorithm,type,distribution,n,ns_per_element,comparisons,allocations,bytes,ok\n");
+	runType<int>();
+	runType<float>();
+	runType<BenchmarkVec4>();
+	runType<Record64>();
+}
+template<class T>inline void Benchmark::runType()
+{
+	using E = BenchmarkElement<T>;
+	using Key = typename E::Key;
+	Key proj;
+	for (int c0(0); c0 < DistributionCount; ++c0)
+	{
+		Distribution d((Distribution)c0);
+		Vector<unsigned int>k(keys(d));
+		Vector<T>input;
+		input.reserve(n);
+		for (int c1(0); c1 < n; ++c1)input.pushBack(E::make(k.data[c1]));
+		//the answer every algorithm is checked against
+		Vector<unsigned int>sorted(k);
+		radixSort(sorted);
+		auto same = [&](T const& a, unsigned int b) {return proj(a) == proj(E::make(b)); };
+		auto isSorted = [&](T const* a)
+		{
+			for (int c1(0); c1 < n; ++c1)
+				if (!same(a[c1], sorted.data[c1]))return false;
+			return true;
+		};
+		measure("qsort", d, input, [&](T* a, int m, auto cmp) {qsort(a, 0, m, cmp, proj); }, isSorted);
+		measure("heapSort", d, input, [&](T* a, int m, auto cmp) {heapSort(a, m, cmp, proj); }, isSorted);
+		measure("stableSort", d, input, [&](T* a, int m, auto cmp) {stableSort(a, 0, m, cmp, proj, BenchmarkAllocator()); }, isSorted);
+		measure("parallelSort", d, input, [&](T* a, int m, auto cmp) {parallelSort(a, 0, m, threads, ParallelSortGrain, cmp, proj, BenchmarkAllocator()); }, isSorted);
+		if constexpr (IsSameType<Key, Identity>::value)
+			measure("radixSort", d, input, [&](T* a, int m, auto) {radixSort(a, 0, m, threads, BenchmarkAllocator()); }, isSorted);
+		//priorityQueue: heapified from a Vector and popped back in order, the check also builds
+		//queues from an empty and a one element Vector
+		measure("priorityQueue", d, input, [&](T* a, int m, auto cmp)
+			{
+				Vector<T>v;
+				v.reserve(m);
+				for (int c1(0); c1 < m; ++c1)v.pushBack(a[c1]);
+				PriorityQueue<T, HeapOrder<decltype(cmp), Key>>queue(v, HeapOrder<decltype(cmp), Key>{ cmp, proj });
+				for (int c1(0); c1 < m; ++c1)
+				{
+					a[c1] = queue.top();
+					queue.pop();
+				}
+			},
+			[&](T const* a)
+			{
+				Vector<T>v;
+				PriorityQueue<T, HeapOrder<Less, Key>>empty(v, HeapOrder<Less, Key>{ Less(), proj });
+				if (!empty.empty())return false;
+				v.pushBack(input.data[0]);
+				PriorityQueue<T, HeapOrder<Less, Key>>one(v, HeapOrder<Less, Key>{ Less(), proj });
+				return one.length() == 1 && proj(one.top()) == proj(input.data[0]) && isSorted(a);
+			});
+		int median(n / 2);
+		measure("nthElement", d, input, [&](T* a, int m, auto cmp) {nthElement(a, 0, median, m, cmp, proj); },
+			[&](T const* a) {return same(a[median], sorted.data[median]); });
+		int top(n / 100 + 1);
+		measure("partialSort", d, input, [&](T* a, int m, auto cmp) {partialSort(a, 0, top, m, cmp, proj); },
+			[&](T const* a)
+			{
+				for (int c1(0); c1 < top; ++c1)
+					if (!same(a[c1], sorted.data[c1]))return false;
+				return true;
+			});
+		//searches: every key of the distribution looked up in the sorted elements
+		Vector<T>table;
+		table.reserve(n);
+		for (int c1(0); c1 < n; ++c1)table.pushBack(E::make(sorted.data[c1]));
+		measureSearch("lowerBound", d, input, [&](auto const& key, auto cmp) {return lowerBound(table.data, 0, n, key, cmp, proj); },
+			[&](int r, auto const& key) {return r < n && !(proj(table.data[r]) < key) && (!r || proj(table.data[r - 1]) < key); });
+		EytzingerArray<T, Less, Key>eytzinger(table, Less(), proj);
+		unsigned long long count(0);
+		EytzingerArray<T, CountingCompare<>, Key>eytzingerCounting(table, CountingCompare<>{ Less(), &count }, proj);
+		measureSearch("eytzinger", d, input, [&](auto const& key, auto cmp)
+			{
+				if constexpr (IsSameType<decltype(cmp), Less>::value)return eytzinger.lowerBound(key);
+				else
+				{
+					count = 0;
+					int r(eytzingerCounting.lowerBound(key));
+					*cmp.count += count;
+					return r;
+				}
+			},
+			[&](int r, auto const& key) {return r && proj(eytzinger[r]) == key; });
+	}
+}
+inline void Benchmark::runThreads()
+{
+	static constexpr unsigned int counts[]{ 1, 2, 4, 8, 16 };
+	::fprintf(out, "threads,n,qsort_ns_per_element,parallelSort_ns_per_element,speedup,ok\n");
+	Vector<unsigned int>k(keys(Distribution::Random));
+	Vector<int>input;
+	input.reserve(n);
+	for (int c0(0); c0 < n; ++c0)input.pushBack(int(k.data[c0]));
+	Vector<int>sorted;
+	long long base(best(input, [](int* a, int m) {qsort(a, 0, m); }, sorted));
+	for (unsigned int c0(0); c0 < sizeof(counts) / sizeof(*counts); ++c0)
+	{
+		Vector<int>r;
+		long long t(best(input, [&](int* a, int m) {parallelSort(a, 0, m, counts[c0]); }, r));
+		bool ok(true);
+		for (int c1(0); c1 < n; ++c1)ok = ok && r.data[c1] == sorted.data[c1];
+		::fprintf(out, "%u,%d,%.3f,%.3f,%.2f,%d\n", counts[c0], n, double(base) / n, double(t) / n, double(base) / t, int(ok));
+		::fflush(out);
+	}
+}
+inline void Benchmark::runSearch()
+{
+	//16 KB, 256 KB and 64 MB of ints
+	static constexpr int sizes[]{ 1 << 12, 1 << 16, 1 << 24 };
+	::fprintf(out, "algorithm,elements,bytes,ns_per_query,ok\n");
+	for (int c0(0); c0 < int(sizeof(sizes) / sizeof(*sizes)); ++c0)
+	{
+		int m(sizes[c0]);
+		Vector<int>table;
+		table.reserve(m);
+		for (int c1(0); c1 < m; ++c1)table.pushBack(2 * c1);
+		EytzingerArray<int>eytzinger(table);
+		BenchmarkRandom random(0x5EA4C400ull + c0);
+		Vector<int>queries;
+		queries.reserve(n);
+		for (int c1(0); c1 < n; ++c1)queries.pushBack(2 * int(random.next() % (unsigned int)m));
+		//search(key) returns the element found, which has to be the key
+		auto lookups = [&](char const* _name, int _queries, auto&& search)
+		{
+			long long b(-1);
+			long long sum(0);
+			Timer timer;
+			for (int c1(0); c1 < repeats; ++c1)
+			{
+				timer.begin();
+				for (int c2(0); c2 < _queries; ++c2)sum += search(queries.data[c2]);
+				timer.end();
+				if (b < 0 || timer.nanoseconds() < b)b = timer.nanoseconds();
+			}
+			bool ok(sum >= 0);
+			for (int c2(0); c2 < _queries; ++c2)ok = ok && search(queries.data[c2]) == queries.data[c2];
+			::fprintf(out, "%s,%d,%llu,%.3f,%d\n", _name, m, (unsigned long long)m * sizeof(int), double(b) / _queries, int(ok));
+			::fflush(out);
+		};
+		//a linear scan of the big tables gets fewer queries, about 2^27 elements in all
+		int linear((1 << 27) / m);
+		lookups("posFirst", linear < 1 ? 1 : linear < n ? linear : n, [&](int key) {return table.data[table.posFirst(key)]; });
+		lookups("branchyLowerBound", n, [&](int key) {return table.data[branchyLowerBound(table.data, 0, m, key)]; });
+		lookups("lowerBound", n, [&](int key) {return table.data[lowerBound(table.data, 0, m, key)]; });
+		lookups("eytzinger", n, [&](int key) {return eytzinger[eytzinger.lowerBound(key)]; });
+	}
+}
+inline void Benchmark::runComparators()
+{
+	static constexpr int m(10000000);
+	::fprintf(out, "algorithm,callable,n,ns_per_element,ok\n");
+	auto row = [&](char const* _name, char const* _callable, long long _ns, bool _ok)
+	{
+		::fprintf(out, "%s,%s,%d,%.3f,%d\n", _name, _callable, m, double(_ns) / m, int(_ok));
+		::fflush(out);
+	};
+	BenchmarkRandom random(0xC0A1ull);
+	Vector<int>input;
+	input.reserve(m);
+	for (int c0(0); c0 < m; ++c0)input.pushBack(int(random.next() >> 8));
+	Vector<int>sorted, r;
+	long long t(best(input, [](int* a, int q) {qsort(a, 0, q, &lessFunction); }, sorted));
+	bool ok(true);
+	for (int c0(1); c0 < m; ++c0)ok = ok && sorted.data[c0 - 1] <= sorted.data[c0];
+	row("qsort", "function_pointer", t, ok);
+	t = best(input, [](int* a, int q) {qsort(a, 0, q, LessFunctor()); }, r);
+	ok = true;
+	for (int c0(0); c0 < m; ++c0)ok = ok && r.data[c0] == sorted.data[c0];
+	row("qsort", "functor", t, ok);
+	//traverse adds 1 to every element, findFirst looks for the last one
+	Vector<int>v(input);
+	t = best([&] {v.traverse(&incrementFunction); });
+	ok = v.data[0] == input.data[0] + repeats && v.data[m - 1] == input.data[m - 1] + repeats;
+	row("traverse", "function_pointer", t, ok);
+	t = best([&] {v.traverse([](int& a) {++a; return true; }); });
+	ok = v.data[0] == input.data[0] + 2 * repeats && v.data[m - 1] == input.data[m - 1] + 2 * repeats;
+	row("traverse", "functor", t, ok);
+	for (int c0(0); c0 < m; ++c0)v.data[c0] = c0;
+	int* found(nullptr);
+	t = best([&] {found = &v.findFirst(&equalFunction, m - 1); });
+	row("findFirst", "function_pointer", t, found == v.data + m - 1);
+	found = nullptr;
+	t = best([&] {found = &v.findFirst([](int const& a, int const& b) {return a == b; }, m - 1); });
+	row("findFirst", "functor", t, found == v.data + m - 1);
+}
+inline void Benchmark::runLists()
+{
+	using Counter = CountingAllocator<>;
+	::fprintf(out, "workload,nodes,n,ns_per_operation,allocations,ok\n");
+	//fill: n pushBack then n popBack, churn: pushBack twice and popBack once n times, then
+	//n popBack, every popBack checks the element it removes. Every repeat builds a new
+	//list: with glibc the slabs of the last one may have been trimmed back to the system
+	//when it was destroyed, so the pool pays the page faults again (see NodePool in
+	//_List.h), per node allocation reuses the nodes freed into malloc's bins.
+	auto workloads = [&](char const* _list, auto make)
+	{
+		for (int c0(0); c0 < 2; ++c0)
+		{
+			bool ok(true);
+			unsigned long long a0(Counter::allocations);
+			long long t(best([&]
+				{
+					auto list(make());
+					for (int c1(0); c1 < n; ++c1)
+					{
+						list->pushBack(c1);
+						if (c0)list->pushBack(c1).popBack();
+					}
+					for (int c1(n - 1); c1 >= 0; --c1)
+					{
+						ok = ok && list->end->data == c1;
+						list->popBack();
+					}
+					ok = ok && !list->length;
+					delete list;
+				}));
+			::fprintf(out, "%s,%s,%d,%.3f,%llu,%d\n", c0 ? "churn" : "fill", _list, n, double(t) / (c0 ? 4.0 * n : 2.0 * n),
+				(Counter::allocations - a0) / repeats, int(ok));
+			::fflush(out);
+		}
+	};
+	workloads("pool", [] {return new List<int, Counter>; });
+	workloads("per_node", [] {return new List<int, PerNodeAllocator<Counter>>; });
+}
+inline void Benchmark::runMixed()
+{
+	//256 operations, a scan of every element or an insert, inserts making 10%, 50% or 90%
+	static constexpr int operations(256);
+	static constexpr int inserts[]{ 10, 50, 90 };
+	int m(n < (1 << 20) ? 1 << 20 : n);
+	::fprintf(out, "workload,container,n,operations,ns_per_operation,ok\n");
+	for (int c0(0); c0 < int(sizeof(inserts) / sizeof(*inserts)); ++c0)
+	{
+		char name[16];
+		::snprintf(name, sizeof(name), "insert_%d", inserts[c0]);
+		//every container sees the same operations, its final elements are hashed for the check
+		unsigned long long reference(0);
+		auto mixed = [&](char const* _container, auto make)
+		{
+			long long b(-1);
+			unsigned long long hash(0);
+			long long sum(0);
+			Timer timer;
+			for (int c1(0); c1 < repeats; ++c1)
+			{
+				auto a(make());
+				for (int c2(0); c2 < m; ++c2)a->pushBack(c2);
+				BenchmarkRandom random(0x31ED0000ull + c0);
+				timer.begin();
+				for (int c2(0); c2 < operations; ++c2)
+				{
+					if (int(random.next() % 100) < inserts[c0])a->insert(int(c2), random.next() % (a->length + 1));
+					else
+					{
+						long long s(0);
+						a->traverse([&s](int const& e) {s += e; return true; });
+						sum += s;
+					}
+				}
+				timer.end();
+				if (b < 0 || timer.nanoseconds() < b)b = timer.nanoseconds();
+				hash = 0;
+				a->traverse([&](int const& e) {hash = hash * 31 + (unsigned int)e; return true; });
+				delete a;
+			}
+			if (!reference)reference = hash;
+			::fprintf(out, "%s,%s,%d,%d,%.3f,%d\n", name, _container, m, operations, double(b) / operations, int(hash == reference && sum >= 0));
+			::fflush(out);
+		};
+		mixed("Vector", [] {return new Vector<int>; });
+		mixed("UnrolledList", [] {return new UnrolledList<int>; });
+		mixed("List", [] {return new List<int>; });
+	}
+}
+inline Vector<unsigned int>Benchmark::keys(Distribution a)const
+{
+	static constexpr unsigned int mask((1u << 24) - 1);
+	Vector<unsigned int>r;
+	r.reserve(n);
+	BenchmarkRandom random(0x5EED0000ull + (unsigned long long)a);
+	switch (a)
+	{
+	case Distribution::Random:
+		for (int c0(0); c0 < n; ++c0)r.pushBack(random.next() & mask);
+		break;
+	case Distribution::Sorted:
+		for (int c0(0); c0 < n; ++c0)r.pushBack(c0 & mask);
+		break;
+	case Distribution::Reverse:
+		for (int c0(0); c0 < n; ++c0)r.pushBack((n - 1 - c0) & mask);
+		break;
+	case Distribution::FewUnique:
+		for (int c0(0); c0 < n; ++c0)r.pushBack(random.next() & 15);
+		break;
+	case Distribution::OrganPipe:
+		for (int c0(0); c0 < n; ++c0)r.pushBack((c0 < n / 2 ? c0 : n - 1 - c0) & mask);
+		break;
+	case Distribution::Zipf:
+	{
+		//rank k drawn with probability proportional to 1 / (k + 1)
+		int m(n < 65536 ? n : 65536);
+		Vector<double>cdf;
+		cdf.reserve(m);
+		double sum(0);
+		for (int c0(0); c0 < m; ++c0)cdf.pushBack(sum += 1.0 / (c0 + 1));
+		for (int c0(0); c0 < n; ++c0)
+		{
+			int k(lowerBound(cdf.data, 0, m, random.uniform() * sum));
+			r.pushBack(k < m ? k : m - 1);
+		}
+		break;
+	}
+	}
+	return r;
+}
+template<class T, class F, class C>inline void Benchmark::measure(char const* _name, Distribution _distribution, Vector<T>const& input, F&& sort, C&& check)
+{
+	long long best(-1);
+	unsigned long long allocations(0), bytes(0);
+	bool ok(true);
+	Timer timer;
+	for (int c0(0); c0 < repeats; ++c0)
+	{
+		Vector<T>work(input);
+		unsigned long long a0(BenchmarkAllocator::allocations + BenchmarkAllocator::reallocations);
+		unsigned long long b0(BenchmarkAllocator::bytes);
+		timer.begin();
+		sort(work.data, n, Less());
+		timer.end();
+		allocations = BenchmarkAllocator::allocations + BenchmarkAllocator::reallocations - a0;
+		bytes = BenchmarkAllocator::bytes - b0;
+		if (best < 0 || timer.nanoseconds() < best)best = timer.nanoseconds();
+		ok = ok && check((T const*)work.data);
+	}
+	unsigned long long comparisons(0);
+	Vector<T>work(input);
+	sort(work.data, n, CountingCompare<>{ Less(), &comparisons });
+	ok = ok && check((T const*)work.data);
+	printRow<T>(_name, _distribution, double(best) / n, comparisons, allocations, bytes, ok);
+}
+template<class T, class F, class C>inline void Benchmark::measureSearch(char const* _name, Distribution _distribution, Vector<T>const& queries, F&& search, C&& check)
+{
+	typename BenchmarkElement<T>::Key proj;
+	long long best(-1);
+	long long sum(0);
+	Timer timer;
+	for (int c0(0); c0 < repeats; ++c0)
+	{
+		timer.begin();
+		for (int c1(0); c1 < n; ++c1)sum += search(proj(queries.data[c1]), Less());
+		timer.end();
+		if (best < 0 || timer.nanoseconds() < best)best = timer.nanoseconds();
+	}
+	unsigned long long comparisons(0);
+	bool ok(sum >= 0);
+	for (int c1(0); c1 < n; ++c1)
+	{
+		auto const& key(proj(queries.data[c1]));
+		ok = check(search(key, CountingCompare<>{ Less(), &comparisons }), key) && ok;
+	}
+	printRow<T>(_name, _distribution, double(best) / n, comparisons, 0, 0, ok);
+}
+template<class T>inline void Benchmark::printRow(char const* _name, Distribution _distribution, double _ns, unsigned long long _comparisons, unsigned long long _allocations, unsigned long long _bytes, bool _ok)
+{
+	::fprintf(out, "%s,%s,%s,%d,%.3f,%llu,%llu,%llu,%d\n", _name, BenchmarkElement<T>::name, DistributionNames[int(_distribution)],
+		n, _ns, _comparisons, _allocations, _bytes, int(_ok));
+	::fflush(out);
+}
+template<class T, class F>inline long long Benchmark::best(Vector<T>const& input, F&& sort, Vector<T>& r)
+{
+	long long b(-1);
+	Timer timer;
+	for (int c0(0); c0 < repeats; ++c0)
+	{
+		r = input;
+		timer.begin();
+		sort(r.data, r.length);
+		timer.end();
+		if (b < 0 || timer.nanoseconds() < b)b = timer.nanoseconds();
+	}
+	return b;
+}
+template<class F>inline long long Benchmark::best(F&& f)
+{
+	long long b(-1);
+	Timer timer;
+	for (int c0(0); c0 < repeats; ++c0)
+	{
+		timer.begin();
+		f();
+		timer.end();
+		if (b < 0 || timer.nanoseconds() < b)b = timer.nanoseconds();
+	}
+	return b;
+}
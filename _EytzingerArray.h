@@ -0,0 +1,145 @@
+#pragma once
+#include <_Vector.h>
+#include <_Algorithm.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//Sorted array stored in breadth first order (Eytzinger layout): node k at data[k] has
+//its children at 2k and 2k + 1, data[0] is unused. A search walks down from node 1, so
+//the first levels stay hot in cache for every lookup, and the 16 great grandchildren
+//four levels below (for 4 byte T) share one cache line that is prefetched while the
+//current levels are compared. Built once from a sorted range, for lookup heavy tables.
+//Searches return the node index, 0 if there is none, and data[k] is the element.
+template<class T, class Compare = Less, class Projection = Identity>struct EytzingerArray
+{
+	AlignedVector<T, 64>data;
+	int length;
+	Compare cmp;
+	Projection proj;
+
+	//Construction
+	EytzingerArray(Compare const& = Compare(), Projection const& = Projection());
+	EytzingerArray(T const*, int, Compare const& = Compare(), Projection const& = Projection());
+	template<class Growth, class Allocator>EytzingerArray(Vector<T, Growth, Allocator>const&, Compare const& = Compare(), Projection const& = Projection());
+	//build from the sorted a[0, n)
+	EytzingerArray& build(T const*, int);
+	//element
+	T const& operator[](int)const;
+	//search
+	template<class K>int lowerBound(K const&)const;
+	template<class K>int upperBound(K const&)const;
+	template<class K>T const* find(K const&)const;
+	//sorted order
+	Vector<T>toSorted()const;
+
+	int fill(T const*, int, int);
+	//node the search lands on once it has left the tree at k
+	static int landing(unsigned int);
+};
+
+//Construction
+template<class T, class Compare, class Projection>inline EytzingerArray<T, Compare, Projection>::EytzingerArray(Compare const& _cmp, Projection const& _proj)
+	:
+	data(),
+	length(0),
+	cmp(_cmp),
+	proj(_proj)
+{
+}
+template<class T, class Compare, class Projection>inline EytzingerArray<T, Compare, Projection>::EytzingerArray(T const* a, int n, Compare const& _cmp, Projection const& _proj)
+	:
+	EytzingerArray(_cmp, _proj)
+{
+	build(a, n);
+}
+template<class T, class Compare, class Projection>template<class Growth, class Allocator>inline EytzingerArray<T, Compare, Projection>::EytzingerArray(Vector<T, Growth, Allocator>const& a, Compare const& _cmp, Projection const& _proj)
+	:
+	EytzingerArray(_cmp, _proj)
+{
+	build(a.data, a.length);
+}
+template<class T, class Compare, class Projection>inline EytzingerArray<T, Compare, Projection>& EytzingerArray<T, Compare, Projection>::build(T const* a, int n)
+{
+	length = n;
+	data.resize(n + 1);
+	fill(a, 0, 1);
+	return *this;
+}
+//element
+template<class T, class Compare, class Projection>inline T const& EytzingerArray<T, Compare, Projection>::operator[](int k)const
+{
+	return data.data[k];
+}
+//search
+//lowerBound: node of the first element with !(element < key)
+template<class T, class Compare, class Projection>template<class K>inline int EytzingerArray<T, Compare, Projection>::lowerBound(K const& key)const
+{
+	static constexpr size_t ahead(sizeof(T) < 64 ? 64 / sizeof(T) : 1);
+	T const* d(data.data);
+	unsigned int k(1);
+	while (k <= (unsigned int)length)
+	{
+		prefetchRead((char const*)d + k * ahead * sizeof(T));
+		k = 2 * k + cmp(proj(d[k]), key);
+	}
+	return landing(k);
+}
+//upperBound: node of the first element with key < element
+template<class T, class Compare, class Projection>template<class K>inline int EytzingerArray<T, Compare, Projection>::upperBound(K const& key)const
+{
+	static constexpr size_t ahead(sizeof(T) < 64 ? 64 / sizeof(T) : 1);
+	T const* d(data.data);
+	unsigned int k(1);
+	while (k <= (unsigned int)length)
+	{
+		prefetchRead((char const*)d + k * ahead * sizeof(T));
+		k = 2 * k + !cmp(key, proj(d[k]));
+	}
+	return landing(k);
+}
+template<class T, class Compare, class Projection>template<class K>inline T const* EytzingerArray<T, Compare, Projection>::find(K const& key)const
+{
+	int k(lowerBound(key));
+	if (!k || cmp(key, proj(data.data[k])))return nullptr;
+	return data.data + k;
+}
+//sorted order
+template<class T, class Compare, class Projection>inline Vector<T>EytzingerArray<T, Compare, Projection>::toSorted()const
+{
+	Vector<T>r;
+	r.reserve(length);
+	//in order walk: leftmost node, then successor by climbing out of right subtrees
+	unsigned int k(1);
+	while (2 * k <= (unsigned int)length)k *= 2;
+	for (int c1(0); c1 < length; ++c1)
+	{
+		r.pushBack(data.data[k]);
+		if (2 * k + 1 <= (unsigned int)length)
+		{
+			k = 2 * k + 1;
+			while (2 * k <= (unsigned int)length)k *= 2;
+		}
+		else k = landing(2 * k + 1);
+	}
+	return r;
+}
+//fill: in order walk of the subtree at k taking a[n...], returns the next n
+template<class T, class Compare, class Projection>inline int EytzingerArray<T, Compare, Projection>::fill(T const* a, int n, int k)
+{
+	if (k > length)return n;
+	n = fill(a, n, 2 * k);
+	data.data[k] = a[n++];
+	return fill(a, n, 2 * k + 1);
+}
+//landing: the last left turn was the answer, so drop the right turns after it and that turn
+template<class T, class Compare, class Projection>inline int EytzingerArray<T, Compare, Projection>::landing(unsigned int k)
+{
+#ifdef _MSC_VER
+	unsigned long r;
+	_BitScanForward(&r, ~k);
+	return int(k >> (r + 1));
+#else
+	return int(k >> (__builtin_ctz(~k) + 1));
+#endif
+}
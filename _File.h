@@ -1,5 +1,6 @@
 #pragma once
 #include <_Vector.h>
+#include <_StableVector.h>
 #include <_String.h>
 #include <cstdlib>
 #include <io.h>
@@ -39,7 +40,7 @@ struct File
 	//Menbers
 	bool valid;					//if this file valid, true
 	Property property;			//file attribs
-	Vector<File>childs;			//childs
+	StableVector<File>childs;	//childs, never moved so that father stays valid
 	File* father;				//pointer to father
 
 	//Construction
@@ -225,9 +226,9 @@ inline void File::build()
 	while (flag)
 	{
 		if (tempFileInfo.attrib & _A_SUBDIR)
-			childs.pushBack(File(tempFileInfo, property.path + tempFileInfo.name + "/", this));
+			childs.emplaceBack(tempFileInfo, property.path + tempFileInfo.name + "/", this);
 		else
-			childs.pushBack(File(tempFileInfo, tempPath, this));
+			childs.emplaceBack(tempFileInfo, tempPath, this);
 		flag = !_findnext64(handle, &tempFileInfo);
 	}
 	_findclose(handle);
@@ -245,9 +246,9 @@ inline void File::build(String<char>const& _path)
 		if (strcmp(tempFileInfo.name, ".") && strcmp(tempFileInfo.name, ".."))
 		{
 			if (tempFileInfo.attrib & _A_SUBDIR)
-				childs.pushBack(File(tempFileInfo, _path + tempFileInfo.name + "/", this));
+				childs.emplaceBack(tempFileInfo, _path + tempFileInfo.name + "/", this);
 			else
-				childs.pushBack(File(tempFileInfo, tempPath, this));
+				childs.emplaceBack(tempFileInfo, tempPath, this);
 		}
 		flag = !_findnext64(handle, &tempFileInfo);
 	}
@@ -258,7 +259,7 @@ inline File& File::findInThis(String<char>const& a)
 {
 	for (int c1(0); c1 < childs.length; c1++)
 	{
-		if (a == childs.data[c1].property.file.name)return childs.data[c1];
+		if (a == childs[c1].property.file.name)return childs[c1];
 	}
 	return *(File*)nullptr;
 }
@@ -338,5 +339,5 @@ inline void File::print()const
 	if (property.path.data)property.path.print();
 	if (!property.isFolder)printf("%s", property.file.name);
 	::printf("\n");
-	for (int c1(0); c1 < childs.length; c1++)childs.data[c1].print();
+	for (int c1(0); c1 < childs.length; c1++)childs[c1].print();
 }
\ No newline at end of file
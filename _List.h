@@ -1,10 +1,21 @@
 #pragma once
 #include <_Vector.h>
+#include <_Allocator.h>
 #include <typeinfo>
 #include <initializer_list>
 #include <new>
 
-template<class T>struct List
+//PerNodeAllocator: a List with it takes every node from Base on its own and gives it
+//back on removal, as before the NodePool, to measure the pool against or for lists
+//that hand single nodes between threads
+template<class NodeBase = DefaultAllocator>struct PerNodeAllocator :NodeBase
+{
+	using Base = NodeBase;
+};
+template<class Allocator>struct IsPerNodeAllocator :False {};
+template<class Base>struct IsPerNodeAllocator<PerNodeAllocator<Base>> :True {};
+
+template<class T, class Allocator = DefaultAllocator>struct List
 {
 	struct ListNode
 	{
@@ -18,37 +29,122 @@ template<class T>struct List
 		ListNode(T const&, ListNode*);
 		~ListNode();
 	};
+	//Nodes are cut from slabs of 8, 16... 1024 nodes, freed nodes go to a free list and
+	//are reused first, and ~List gives the slabs back at once instead of node by node.
+	//Lists exchanging nodes (splice, merge) join their pools: the joined one hands its
+	//slabs to the other and forwards to it through parent, every pool is freed by the
+	//last list or pool referring to it. A PerNodeAllocator leaves the pool out.
+	//With 2^20 ints (Benchmark.cpp lists, g++ -O2) a pushBack or popBack takes 6-9 ns
+	//from the pool against 13-18 ns per node, as long as the slabs stay mapped. glibc
+	//trims the slabs of a big list back to the system when it is destroyed though, and
+	//the next list then pays a page fault per 4 KB: 11-18 ns, no faster than per node
+	//allocation, whose nodes stay in malloc's bins.
+	struct NodePool
+	{
+		struct Slab
+		{
+			Slab* next;
+			unsigned int length;
+		};
+		static constexpr size_t nodeOffset = (sizeof(Slab) + alignof(ListNode) - 1) / alignof(ListNode) * alignof(ListNode);
+		static constexpr unsigned int slabFirst = 8;
+		static constexpr unsigned int slabMax = 1024;
+
+		Slab* slabs;
+		void* freeNodes;
+		ListNode* bump;
+		ListNode* bumpEnd;
+		unsigned int refs;
+		NodePool* parent;
+
+		static NodePool* create();
+		void release();
+		NodePool* root();
+		void join(NodePool*);
+		ListNode* allocate();
+		void deallocate(ListNode*);
+	};
+
+	//Bidirectional iterator, the one past end has node == nullptr
+	template<class R>struct Iter
+	{
+		ListNode* node;
+		List const* list;
+
+		R& operator*()const;
+		R* operator->()const;
+		Iter& operator++();
+		Iter& operator--();
+		Iter operator++(int);
+		Iter operator--(int);
+		bool operator==(Iter const&)const;
+		bool operator!=(Iter const&)const;
+	};
+	using Iterator = Iter<T>;
+	using ConstIterator = Iter<T const>;
 
 	ListNode* begin;
 	ListNode* end;
 	unsigned int length;
+	NodePool* pool;
+	ListNode* cursor;			//last node reached by operator[], nullptr if unknown
+	unsigned int cursorPos;		//its position
 
 	List();
 	List(T const&);
-	List(List<T> const&);
+	List(List<T, Allocator> const&);
 	List(std::initializer_list<T>const&);
 
 
 	~List();
 
+	List<T, Allocator>& operator=(List<T, Allocator>const&);
+
 	ListNode& operator[] (unsigned int);
+	Iterator itBegin();
+	Iterator itEnd();
+	ConstIterator itBegin()const;
+	ConstIterator itEnd()const;
 
-	List<T>& pushBack(T const&);
-	List<T>& popBack();
-	List<T>& insert(T const&, unsigned int);
-	List<T>& omit(unsigned int);
+	List<T, Allocator>& pushBack(T const&);
+	List<T, Allocator>& popBack();
+	List<T, Allocator>& insert(T const&, unsigned int);
+	List<T, Allocator>& omit(unsigned int);
+	ListNode& insertAfter(ListNode&, T const&);
+	ListNode& insertBefore(ListNode&, T const&);
+	ListNode* erase(ListNode&);
 
 	template<class R>ListNode& find(R const&);
 	ListNode& find(T const&);
 	bool traverse(bool(*p)(T const&))const;
 	bool check(bool(*p)(T const&));
+	template<class F>bool traverse(F&&)const;
+	template<class F>bool check(F&&);
+	//move nodes of a (may be this) before pos, pos nullptr means at the end
+	List<T, Allocator>& splice(ListNode*, List<T, Allocator>&);
+	List<T, Allocator>& splice(ListNode*, List<T, Allocator>&, ListNode&);
+	List<T, Allocator>& splice(ListNode*, List<T, Allocator>&, ListNode&, ListNode&);
+	List<T, Allocator>& splice(ListNode*, List<T, Allocator>&, ListNode&, ListNode&, unsigned int);
+	//merge sorted a into this sorted list, stable: equal elements of this come first
+	List<T, Allocator>& merge(List<T, Allocator>&);
+	template<class F>List<T, Allocator>& merge(List<T, Allocator>&, F&&);
+	//stable bottom-up merge sort, only relinks nodes
+	List<T, Allocator>& sort();
+	template<class F>List<T, Allocator>& sort(F&&);
 
 	void printInfo()const;
 	void printInfo(char const*, bool(*p)(T const&))const;
+
+	ListNode* allocateNode();
+	void deallocateNode(ListNode*);
+	NodePool* livePool();
+	void sharePool(List<T, Allocator>&);
+	void relinkPre();
+	template<class F>static ListNode* mergeChains(ListNode*, ListNode*, F&);
 };
 
 //ListNode
-template<class T>inline List<T>::ListNode::ListNode()
+template<class T, class Allocator>inline List<T, Allocator>::ListNode::ListNode()
 	:
 	data(),
 	pre(nullptr),
@@ -56,14 +152,14 @@ template<class T>inline List<T>::ListNode::ListNode()
 {
 
 }
-template<class T>inline List<T>::ListNode::ListNode(T const& _data)
+template<class T, class Allocator>inline List<T, Allocator>::ListNode::ListNode(T const& _data)
 	:
 	data(_data),
 	pre(nullptr),
 	suc(nullptr)
 {
 }
-template<class T>inline List<T>::ListNode::ListNode(ListNode* _pre, T const& _data)
+template<class T, class Allocator>inline List<T, Allocator>::ListNode::ListNode(ListNode* _pre, T const& _data)
 	:
 	data(_data),
 	pre(_pre)
@@ -80,7 +176,7 @@ template<class T>inline List<T>::ListNode::ListNode(ListNode* _pre, T const& _da
 		suc = nullptr;
 	}
 }
-template<class T>inline List<T>::ListNode::ListNode(T const& _data, ListNode* _suc)
+template<class T, class Allocator>inline List<T, Allocator>::ListNode::ListNode(T const& _data, ListNode* _suc)
 	:
 	data(_data),
 	suc(_suc)
@@ -98,7 +194,7 @@ template<class T>inline List<T>::ListNode::ListNode(T const& _data, ListNode* _s
 	}
 }
 
-template<class T>inline List<T>::ListNode::~ListNode()
+template<class T, class Allocator>inline List<T, Allocator>::ListNode::~ListNode()
 {
 	if (pre)
 	{
@@ -119,26 +215,34 @@ template<class T>inline List<T>::ListNode::~ListNode()
 }
 
 //List
-template<class T>inline List<T>::List()
+template<class T, class Allocator>inline List<T, Allocator>::List()
 	:
 	begin(nullptr),
 	end(nullptr),
-	length(0)
+	length(0),
+	pool(nullptr),
+	cursor(nullptr),
+	cursorPos(0)
 {
 }
-template<class T>inline List<T>::List(T const& _data)
+template<class T, class Allocator>inline List<T, Allocator>::List(T const& _data)
 	:
-	begin(new((ListNode*)::malloc(sizeof(ListNode)))ListNode(_data)),
-	end(begin),
-	length(1)
+	pool(nullptr),
+	cursor(nullptr),
+	cursorPos(0)
 {
+	begin = end = new(allocateNode())ListNode(_data);
+	length = 1;
 }
-template<class T>inline List<T>::List(List<T> const& a)
+template<class T, class Allocator>inline List<T, Allocator>::List(List<T, Allocator> const& a)
 	:
-	length(a.length)
+	length(a.length),
+	pool(nullptr),
+	cursor(nullptr),
+	cursorPos(0)
 {
 	ListNode* t(a.begin);
-	if (t)begin = new((ListNode*)::malloc(sizeof(ListNode)))ListNode(a.begin->data);
+	if (t)begin = new(allocateNode())ListNode(a.begin->data);
 	else
 	{
 		begin = nullptr;
@@ -147,21 +251,24 @@ template<class T>inline List<T>::List(List<T> const& a)
 	};
 	ListNode* k(begin);
 	while (t = t->suc)
-		k = new((ListNode*)::malloc(sizeof(ListNode)))ListNode(k, t->data);
+		k = new(allocateNode())ListNode(k, t->data);
 	end = k;
 }
-template<class T>inline List<T>::List(std::initializer_list<T> const& a)
+template<class T, class Allocator>inline List<T, Allocator>::List(std::initializer_list<T> const& a)
 	:
-	length(a.size())
+	length(a.size()),
+	pool(nullptr),
+	cursor(nullptr),
+	cursorPos(0)
 {
 	if (length)
 	{
 		unsigned int c0(0);
 		T const* p(a.begin());
-		begin = new((ListNode*)::malloc(sizeof(ListNode)))ListNode(*p);
+		begin = new(allocateNode())ListNode(*p);
 		ListNode* t(begin);
 		while (++c0 < length)
-			t = new((ListNode*)::malloc(sizeof(ListNode)))ListNode(t, p[c0]);
+			t = new(allocateNode())ListNode(t, p[c0]);
 		end = t;
 	}
 	else
@@ -171,131 +278,169 @@ template<class T>inline List<T>::List(std::initializer_list<T> const& a)
 	}
 }
 
-template<class T>inline List<T>::~List()
+template<class T, class Allocator>inline List<T, Allocator>::~List()
 {
+	bool shared(IsPerNodeAllocator<Allocator>::value || (pool && livePool()->refs > 1));
 	while (begin)
 	{
 		(&(begin->data))->~T();
 		ListNode* t(begin->suc);
-		::free(begin);
+		if (shared)deallocateNode(begin);
 		begin = t;
 	}
+	end = nullptr;
+	length = 0;
+	cursor = nullptr;
+	if (pool)pool->release();
+	pool = nullptr;
+}
+//operator=: the default one would share nodes and the pool
+template<class T, class Allocator>inline List<T, Allocator>& List<T, Allocator>::operator=(List<T, Allocator>const& a)
+{
+	if (this == &a)return *this;
+	this->~List();
+	new(this)List(a);
+	return *this;
 }
 
-template<class T>inline typename List<T>::ListNode& List<T>::operator[](unsigned int n)
+//operator[]: walks from the nearest of begin, end and the cursor, so sequential
+//indexed access (and insert/omit in a loop) costs O(1) per call
+template<class T, class Allocator>inline typename List<T, Allocator>::ListNode& List<T, Allocator>::operator[](unsigned int n)
 {
 	if (n >= length)
 		return *(ListNode*)nullptr;
-	ListNode * r;
-	if (n <= (length << 1))
+	ListNode* r;
+	unsigned int p;
+	unsigned int d;
+	if (n <= length - 1 - n)
 	{
 		r = begin;
-		while (n--)
-			r = r->suc;
-		return *r;
+		p = 0;
+		d = n;
 	}
 	else
 	{
 		r = end;
-		n = length - n;
-		while (--n)
-			r = r->pre;
-		return *r;
+		p = length - 1;
+		d = length - 1 - n;
+	}
+	if (cursor && (cursorPos > n ? cursorPos - n : n - cursorPos) < d)
+	{
+		r = cursor;
+		p = cursorPos;
+	}
+	while (p < n)
+	{
+		r = r->suc;
+		++p;
+	}
+	while (p > n)
+	{
+		r = r->pre;
+		--p;
 	}
+	cursor = r;
+	cursorPos = n;
+	return *r;
+}
+template<class T, class Allocator>inline typename List<T, Allocator>::Iterator List<T, Allocator>::itBegin()
+{
+	return Iterator{ begin, this };
+}
+template<class T, class Allocator>inline typename List<T, Allocator>::Iterator List<T, Allocator>::itEnd()
+{
+	return Iterator{ nullptr, this };
+}
+template<class T, class Allocator>inline typename List<T, Allocator>::ConstIterator List<T, Allocator>::itBegin()const
+{
+	return ConstIterator{ begin, this };
+}
+template<class T, class Allocator>inline typename List<T, Allocator>::ConstIterator List<T, Allocator>::itEnd()const
+{
+	return ConstIterator{ nullptr, this };
 }
 
-template<class T>inline List<T>& List<T>::pushBack(T const& _data)
+template<class T, class Allocator>inline List<T, Allocator>& List<T, Allocator>::pushBack(T const& _data)
 {
 	if (begin)
-		end = new((ListNode*)::malloc(sizeof(ListNode)))ListNode(end, _data);
+		end = new(allocateNode())ListNode(end, _data);
 	else
-		end = begin = new((ListNode*)::malloc(sizeof(ListNode)))ListNode(_data);
+		end = begin = new(allocateNode())ListNode(_data);
 	++length;
 	return *this;
 }
-template<class T>inline List<T>& List<T>::popBack()
+template<class T, class Allocator>inline List<T, Allocator>& List<T, Allocator>::popBack()
+{
+	if (begin)erase(*end);
+	return *this;
+}
+template<class T, class Allocator>inline List<T, Allocator>& List<T, Allocator>::insert(T const& a, unsigned int n)
 {
-	if (begin != end)
+	if (n >= length)return pushBack(a);
+	if (n)
 	{
-		end = end->pre;
-		end->suc->~ListNode();
-		::free(end->suc);
-		end->suc = nullptr;
-		--length;
+		ListNode& k(operator[](n - 1));
+		insertAfter(k, a);
+		cursor = &k;
+		cursorPos = n - 1;
 	}
 	else
 	{
-		if (begin)
-		{
-			begin->~ListNode();
-			::free(begin);
-			begin = end = nullptr;
-			--length;
-		}
+		unsigned int t(cursorPos);
+		ListNode* k(cursor);
+		insertBefore(*begin, a);
+		cursor = k;
+		cursorPos = t + 1;
 	}
 	return *this;
 }
-template<class T>inline List<T>& List<T>::insert(T const& a, unsigned int n)
+template<class T, class Allocator>inline List<T, Allocator>& List<T, Allocator>::omit(unsigned int n)
 {
-	if (length)
+	if (n >= length)
 	{
-		if (n)
-		{
-			if (length >= n)
-				new((ListNode*)::malloc(sizeof(ListNode)))ListNode(&operator[](n - 1), a);
-			else
-				end = new((ListNode*)::malloc(sizeof(ListNode)))ListNode(end, a);
-		}
-		else
-			new((ListNode*)::malloc(sizeof(ListNode)))ListNode(a, begin);
+		if (length)erase(*end);
+		return *this;
 	}
-	else
-		begin = end = new((ListNode*)::malloc(sizeof(ListNode)))ListNode(a);
-	++length;
-	return *this;
-}
-template<class T>inline List<T>& List<T>::omit(unsigned int n)
-{
-	if (length)
+	ListNode& t(operator[](n));
+	ListNode* k(t.pre);
+	erase(t);
+	if (k)
 	{
-		if (length > 1)
-		{
-			if (n + 1 >= length)
-			{
-				end = end->pre;
-				end->suc->~ListNode();
-				::free(end->suc);
-				end->suc = nullptr;
-			}
-			else
-			{
-				if (n)
-				{
-					ListNode& t(operator[](n));
-					t.pre->suc = t.suc;
-					t.suc->pre = t.pre;
-					(&t)->~ListNode();
-					::free(&t);
-				}
-				else
-				{
-					begin = begin->suc;
-					begin->pre->~ListNode();
-					::free(begin->pre);
-				}
-			}
-		}
-		else
-		{
-			begin->~ListNode();
-			::free(begin);
-			begin = end = nullptr;
-		}
-		--length;
+		cursor = k;
+		cursorPos = n - 1;
 	}
 	return *this;
 }
-template<class T>template<class R>	inline typename List<T>::ListNode& List<T>::find(R const& a)
+//insertAfter/insertBefore/erase: O(1) edits at a node, they forget the cursor
+template<class T, class Allocator>inline typename List<T, Allocator>::ListNode& List<T, Allocator>::insertAfter(ListNode& a, T const& b)
+{
+	ListNode* r(new(allocateNode())ListNode(&a, b));
+	if (&a == end)end = r;
+	++length;
+	cursor = nullptr;
+	return *r;
+}
+template<class T, class Allocator>inline typename List<T, Allocator>::ListNode& List<T, Allocator>::insertBefore(ListNode& a, T const& b)
+{
+	ListNode* r(new(allocateNode())ListNode(b, &a));
+	if (&a == begin)begin = r;
+	++length;
+	cursor = nullptr;
+	return *r;
+}
+//erase: returns the node after it, nullptr if it was the end
+template<class T, class Allocator>inline typename List<T, Allocator>::ListNode* List<T, Allocator>::erase(ListNode& a)
+{
+	ListNode* r(a.suc);
+	if (&a == begin)begin = r;
+	if (&a == end)end = a.pre;
+	(&a)->~ListNode();
+	deallocateNode(&a);
+	--length;
+	cursor = nullptr;
+	return r;
+}
+template<class T, class Allocator>template<class R>	inline typename List<T, Allocator>::ListNode& List<T, Allocator>::find(R const& a)
 {
 	ListNode* t(begin);
 	while (t)
@@ -306,7 +451,7 @@ template<class T>template<class R>	inline typename List<T>::ListNode& List<T>::f
 	}
 	return *(ListNode*)nullptr;
 }
-template<class T>					inline typename List<T>::ListNode& List<T>::find(T const& a)
+template<class T, class Allocator>					inline typename List<T, Allocator>::ListNode& List<T, Allocator>::find(T const& a)
 {
 	ListNode* t(begin);
 	while (t)
@@ -317,7 +462,7 @@ template<class T>					inline typename List<T>::ListNode& List<T>::find(T const&
 	}
 	return *(ListNode*)nullptr;
 }
-template<class T>inline bool List<T>::traverse(bool(*p)(T const&)) const
+template<class T, class Allocator>inline bool List<T, Allocator>::traverse(bool(*p)(T const&)) const
 {
 	ListNode* t(begin);
 	while (t)
@@ -327,8 +472,25 @@ template<class T>inline bool List<T>::traverse(bool(*p)(T const&)) const
 	}
 	return true;
 }
-template<class T>inline bool List<T>::check(bool(*p)(T const&))
+template<class T, class Allocator>inline bool List<T, Allocator>::check(bool(*p)(T const&))
+{
+	return check<bool(*)(T const&)>(std::move(p));
+}
+//traverse with any callable (lambdas with captures too), can be inlined
+template<class T, class Allocator>template<class F>inline bool List<T, Allocator>::traverse(F&& p) const
+{
+	ListNode* t(begin);
+	while (t)
+	{
+		if (!p((T const&)t->data))return false;
+		t = t->suc;
+	}
+	return true;
+}
+//check: remove every node that p(data) is false
+template<class T, class Allocator>template<class F>inline bool List<T, Allocator>::check(F&& p)
 {
+	cursor = nullptr;
 	ListNode* t(begin);
 	while (t)
 	{
@@ -346,7 +508,7 @@ template<class T>inline bool List<T>::check(bool(*p)(T const&))
 			}
 			--length;
 			t->~ListNode();
-			::free(t);
+			deallocateNode(t);
 			t = k;
 			continue;
 		}
@@ -354,12 +516,110 @@ template<class T>inline bool List<T>::check(bool(*p)(T const&))
 	}
 	return false;
 }
+//splice: all of a, O(1)
+template<class T, class Allocator>inline List<T, Allocator>& List<T, Allocator>::splice(ListNode* pos, List<T, Allocator>& a)
+{
+	if (&a == this || !a.begin)return *this;
+	return splice(pos, a, *a.begin, *a.end, a.length);
+}
+//splice: one node of a, O(1)
+template<class T, class Allocator>inline List<T, Allocator>& List<T, Allocator>::splice(ListNode* pos, List<T, Allocator>& a, ListNode& b)
+{
+	return splice(pos, a, b, b, 1);
+}
+//splice: [first, last] of a, counts the nodes if a is another list
+template<class T, class Allocator>inline List<T, Allocator>& List<T, Allocator>::splice(ListNode* pos, List<T, Allocator>& a, ListNode& first, ListNode& last)
+{
+	unsigned int n(0);
+	if (&a != this)
+		for (ListNode* t(&first); t != last.suc; t = t->suc)++n;
+	return splice(pos, a, first, last, n);
+}
+//splice: [first, last] of a holding n nodes, O(1), pos must not be inside the range
+template<class T, class Allocator>inline List<T, Allocator>& List<T, Allocator>::splice(ListNode* pos, List<T, Allocator>& a, ListNode& first, ListNode& last, unsigned int n)
+{
+	if (pos == &first || (pos && pos == last.suc))return *this;
+	sharePool(a);
+	//unlink from a
+	if (first.pre)first.pre->suc = last.suc;
+	else a.begin = last.suc;
+	if (last.suc)last.suc->pre = first.pre;
+	else a.end = first.pre;
+	//link before pos
+	ListNode* t(pos ? pos->pre : end);
+	first.pre = t;
+	last.suc = pos;
+	if (t)t->suc = &first;
+	else begin = &first;
+	if (pos)pos->pre = &last;
+	else end = &last;
+	if (&a != this)
+	{
+		a.length -= n;
+		length += n;
+	}
+	a.cursor = nullptr;
+	cursor = nullptr;
+	return *this;
+}
+template<class T, class Allocator>inline List<T, Allocator>& List<T, Allocator>::merge(List<T, Allocator>& a)
+{
+	return merge(a, [](T const& x, T const& y) {return x < y; });
+}
+template<class T, class Allocator>template<class F>inline List<T, Allocator>& List<T, Allocator>::merge(List<T, Allocator>& a, F&& cmp)
+{
+	if (&a == this || !a.begin)return *this;
+	sharePool(a);
+	if (end)end->suc = nullptr;
+	begin = mergeChains(begin, a.begin, cmp);
+	relinkPre();
+	length += a.length;
+	a.begin = a.end = nullptr;
+	a.length = 0;
+	a.cursor = nullptr;
+	cursor = nullptr;
+	return *this;
+}
+template<class T, class Allocator>inline List<T, Allocator>& List<T, Allocator>::sort()
+{
+	return sort([](T const& x, T const& y) {return x < y; });
+}
+//sort: bins[c0] holds a sorted run of 2^c0 nodes (or none), like a binary counter;
+//older runs are always the first argument of mergeChains, which keeps it stable
+template<class T, class Allocator>template<class F>inline List<T, Allocator>& List<T, Allocator>::sort(F&& cmp)
+{
+	if (length < 2)return *this;
+	ListNode* bins[64] = { nullptr };
+	unsigned int binNum(0);
+	ListNode* t(begin);
+	while (t)
+	{
+		ListNode* carry(t);
+		t = t->suc;
+		carry->suc = nullptr;
+		unsigned int c0(0);
+		for (; c0 < binNum && bins[c0]; ++c0)
+		{
+			carry = mergeChains(bins[c0], carry, cmp);
+			bins[c0] = nullptr;
+		}
+		bins[c0] = carry;
+		if (c0 == binNum)++binNum;
+	}
+	ListNode* r(nullptr);
+	for (unsigned int c0(0); c0 < binNum; ++c0)
+		if (bins[c0])r = r ? mergeChains(bins[c0], r, cmp) : bins[c0];
+	begin = r;
+	relinkPre();
+	cursor = nullptr;
+	return *this;
+}
 
-template<class T>inline void List<T>::printInfo() const
+template<class T, class Allocator>inline void List<T, Allocator>::printInfo() const
 {
 	::printf("[List<%s>, %u]\n", typeid(T).name(), length);
 }
-template<class T>inline void List<T>::printInfo(char const* a, bool(*p)(T const&)) const
+template<class T, class Allocator>inline void List<T, Allocator>::printInfo(char const* a, bool(*p)(T const&)) const
 {
 	::printf("[%s: List<%s>, [%u]", a, typeid(T).name(), length);
 	traverse(p);
@@ -367,3 +627,199 @@ template<class T>inline void List<T>::printInfo(char const* a, bool(*p)(T const&
 }
 
 
+
+//Iter
+template<class T, class Allocator>template<class R>inline R& List<T, Allocator>::Iter<R>::operator*()const
+{
+	return node->data;
+}
+template<class T, class Allocator>template<class R>inline R* List<T, Allocator>::Iter<R>::operator->()const
+{
+	return &node->data;
+}
+template<class T, class Allocator>template<class R>inline typename List<T, Allocator>::template Iter<R>& List<T, Allocator>::Iter<R>::operator++()
+{
+	node = node->suc;
+	return *this;
+}
+//operator--: from the one past end goes back to end
+template<class T, class Allocator>template<class R>inline typename List<T, Allocator>::template Iter<R>& List<T, Allocator>::Iter<R>::operator--()
+{
+	node = node ? node->pre : list->end;
+	return *this;
+}
+template<class T, class Allocator>template<class R>inline typename List<T, Allocator>::template Iter<R> List<T, Allocator>::Iter<R>::operator++(int)
+{
+	Iter r(*this);
+	node = node->suc;
+	return r;
+}
+template<class T, class Allocator>template<class R>inline typename List<T, Allocator>::template Iter<R> List<T, Allocator>::Iter<R>::operator--(int)
+{
+	Iter r(*this);
+	node = node ? node->pre : list->end;
+	return r;
+}
+template<class T, class Allocator>template<class R>inline bool List<T, Allocator>::Iter<R>::operator==(Iter const& a)const
+{
+	return node == a.node;
+}
+template<class T, class Allocator>template<class R>inline bool List<T, Allocator>::Iter<R>::operator!=(Iter const& a)const
+{
+	return node != a.node;
+}
+//NodePool
+template<class T, class Allocator>inline typename List<T, Allocator>::NodePool* List<T, Allocator>::NodePool::create()
+{
+	NodePool* r((NodePool*)ElementAllocator<Allocator, ListNode>::allocate(sizeof(NodePool)));
+	r->slabs = nullptr;
+	r->freeNodes = nullptr;
+	r->bump = r->bumpEnd = nullptr;
+	r->refs = 1;
+	r->parent = nullptr;
+	return r;
+}
+template<class T, class Allocator>inline void List<T, Allocator>::NodePool::release()
+{
+	if (--refs)return;
+	while (slabs)
+	{
+		Slab* t(slabs->next);
+		ElementAllocator<Allocator, ListNode>::deallocate(slabs, nodeOffset + slabs->length * sizeof(ListNode));
+		slabs = t;
+	}
+	NodePool* t(parent);
+	ElementAllocator<Allocator, ListNode>::deallocate(this, sizeof(NodePool));
+	if (t)t->release();
+}
+template<class T, class Allocator>inline typename List<T, Allocator>::NodePool* List<T, Allocator>::NodePool::root()
+{
+	NodePool* r(this);
+	while (r->parent)r = r->parent;
+	return r;
+}
+//join: a (a root other than this) gives its slabs and free nodes to this and forwards to it
+template<class T, class Allocator>inline void List<T, Allocator>::NodePool::join(NodePool* a)
+{
+	while (a->bump != a->bumpEnd)deallocate(a->bump++);
+	while (a->freeNodes)
+	{
+		void* t(*(void**)a->freeNodes);
+		deallocate((ListNode*)a->freeNodes);
+		a->freeNodes = t;
+	}
+	if (a->slabs)
+	{
+		Slab* t(a->slabs);
+		while (t->next)t = t->next;
+		//keep the newest slab first, it decides the length of the next one
+		t->next = slabs ? slabs->next : nullptr;
+		if (slabs)slabs->next = a->slabs;
+		else slabs = a->slabs;
+		a->slabs = nullptr;
+	}
+	a->parent = this;
+	++refs;
+}
+template<class T, class Allocator>inline typename List<T, Allocator>::ListNode* List<T, Allocator>::NodePool::allocate()
+{
+	if (freeNodes)
+	{
+		ListNode* r((ListNode*)freeNodes);
+		freeNodes = *(void**)freeNodes;
+		return r;
+	}
+	if (bump == bumpEnd)
+	{
+		unsigned int n(slabs ? slabs->length << 1 : slabFirst);
+		if (n > slabMax)n = slabMax;
+		Slab* t((Slab*)ElementAllocator<Allocator, ListNode>::allocate(nodeOffset + n * sizeof(ListNode)));
+		t->next = slabs;
+		t->length = n;
+		slabs = t;
+		bump = (ListNode*)((char*)t + nodeOffset);
+		bumpEnd = bump + n;
+	}
+	return bump++;
+}
+template<class T, class Allocator>inline void List<T, Allocator>::NodePool::deallocate(ListNode* a)
+{
+	*(void**)a = freeNodes;
+	freeNodes = a;
+}
+//nodes
+template<class T, class Allocator>inline typename List<T, Allocator>::ListNode* List<T, Allocator>::allocateNode()
+{
+	if constexpr (IsPerNodeAllocator<Allocator>::value)
+		return (ListNode*)ElementAllocator<typename Allocator::Base, ListNode>::allocate(sizeof(ListNode));
+	else
+	{
+		if (!pool)pool = NodePool::create();
+		return livePool()->allocate();
+	}
+}
+template<class T, class Allocator>inline void List<T, Allocator>::deallocateNode(ListNode* a)
+{
+	if constexpr (IsPerNodeAllocator<Allocator>::value)
+		ElementAllocator<typename Allocator::Base, ListNode>::deallocate(a, sizeof(ListNode));
+	else
+		livePool()->deallocate(a);
+}
+//livePool: the root pool, pool is moved to it once its own pool was joined
+template<class T, class Allocator>inline typename List<T, Allocator>::NodePool* List<T, Allocator>::livePool()
+{
+	if (pool->parent)
+	{
+		NodePool* r(pool->root());
+		++r->refs;
+		pool->release();
+		pool = r;
+	}
+	return pool;
+}
+//sharePool: before nodes of a move to this
+template<class T, class Allocator>inline void List<T, Allocator>::sharePool(List<T, Allocator>& a)
+{
+	if (!a.pool)return;
+	if (!pool)
+	{
+		pool = a.livePool();
+		++pool->refs;
+		return;
+	}
+	NodePool* r(livePool());
+	if (r != a.livePool())r->join(a.pool);
+}
+//relinkPre: rebuilds pre and end from the suc chain
+template<class T, class Allocator>inline void List<T, Allocator>::relinkPre()
+{
+	ListNode* t(nullptr);
+	for (ListNode* k(begin); k; k = k->suc)
+	{
+		k->pre = t;
+		t = k;
+	}
+	end = t;
+}
+//mergeChains: merges two suc chains, takes from b only when it is strictly smaller
+template<class T, class Allocator>template<class F>inline typename List<T, Allocator>::ListNode* List<T, Allocator>::mergeChains(ListNode* a, ListNode* b, F& cmp)
+{
+	ListNode* r(nullptr);
+	ListNode** t(&r);
+	while (a && b)
+	{
+		if (cmp(b->data, a->data))
+		{
+			*t = b;
+			b = b->suc;
+		}
+		else
+		{
+			*t = a;
+			a = a->suc;
+		}
+		t = &(*t)->suc;
+	}
+	*t = a ? a : b;
+	return r;
+}
@@ -0,0 +1,324 @@
+#pragma once
+#include <_Vector.h>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+//Vector kept in a memory mapped file: the file is just the array of T, so it can be
+//opened again (or read with fread) without a load step, and the OS pages it in and out.
+//Growing extends the file and remaps it, sync() flushes the dirty pages on demand,
+//close() cuts the file back to length elements.
+//Only for plain data, since the bytes are written to disk as they are.
+template<class T, class Growth = DefaultGrowth>struct MappedVector
+{
+	static_assert(__is_trivially_copyable(T), "MappedVector only holds trivially copyable types!");
+	using elementType = T;
+
+	T* data;
+	int length;
+	int lengthAll;
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#else
+	int file;
+#endif
+
+	//Construction
+	MappedVector();
+	MappedVector(char const*);
+	MappedVector(MappedVector const&) = delete;
+	MappedVector(MappedVector&&);
+	//Destruction
+	~MappedVector();
+	//opetrator=
+	MappedVector& operator=(MappedVector const&) = delete;
+	MappedVector& operator=(MappedVector&&);
+	//file
+	bool open(char const*);
+	bool isOpen()const;
+	bool sync();
+	void close();
+	//capacity
+	MappedVector& malloc(unsigned int);
+	MappedVector& reserve(unsigned int);
+	MappedVector& resize(unsigned int);
+	MappedVector& reallocate(int);
+	//element
+	T& begin();
+	T& end();
+	T* endptr();
+	T& operator[](unsigned int);
+	//add...
+	MappedVector& pushBack(T const&);
+	template<class... Args>MappedVector& emplaceBack(Args&&...);
+	MappedVector& popBack();
+	MappedVector& clear();
+	//traverse
+	template<class F>bool traverse(F&&);
+	template<class F>bool traverse(F&&)const;
+	//map the first a elements of the file, unmap if a is 0
+	bool map(int);
+	void unmap();
+};
+
+//Construction
+template<class T, class Growth>inline MappedVector<T, Growth>::MappedVector()
+	:
+	data(nullptr),
+	length(0),
+	lengthAll(0),
+#ifdef _WIN32
+	file(INVALID_HANDLE_VALUE),
+	mapping(nullptr)
+#else
+	file(-1)
+#endif
+{
+}
+template<class T, class Growth>inline MappedVector<T, Growth>::MappedVector(char const* _path)
+	:
+	MappedVector()
+{
+	open(_path);
+}
+template<class T, class Growth>inline MappedVector<T, Growth>::MappedVector(MappedVector&& a)
+	:
+	data(a.data),
+	length(a.length),
+	lengthAll(a.lengthAll),
+#ifdef _WIN32
+	file(a.file),
+	mapping(a.mapping)
+#else
+	file(a.file)
+#endif
+{
+	a.data = nullptr;
+	a.length = a.lengthAll = 0;
+#ifdef _WIN32
+	a.file = INVALID_HANDLE_VALUE;
+	a.mapping = nullptr;
+#else
+	a.file = -1;
+#endif
+}
+//Destruction
+template<class T, class Growth>inline MappedVector<T, Growth>::~MappedVector()
+{
+	close();
+}
+//opetrator=
+template<class T, class Growth>inline MappedVector<T, Growth>& MappedVector<T, Growth>::operator=(MappedVector&& a)
+{
+	if (this == &a)return *this;
+	close();
+	new(this)MappedVector(std::move(a));
+	return *this;
+}
+//file
+//open: creates the file if needed, the elements already in it become [0, length)
+template<class T, class Growth>inline bool MappedVector<T, Growth>::open(char const* _path)
+{
+	close();
+	long long size;
+#ifdef _WIN32
+	file = ::CreateFileA(_path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)return false;
+	LARGE_INTEGER t;
+	::GetFileSizeEx(file, &t);
+	size = t.QuadPart;
+#else
+	file = ::open(_path, O_RDWR | O_CREAT, 0644);
+	if (file == -1)return false;
+	struct stat t;
+	::fstat(file, &t);
+	size = t.st_size;
+#endif
+	length = (int)(size / sizeof(T));
+	if (length && !map(length))
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+template<class T, class Growth>inline bool MappedVector<T, Growth>::isOpen()const
+{
+#ifdef _WIN32
+	return file != INVALID_HANDLE_VALUE;
+#else
+	return file != -1;
+#endif
+}
+template<class T, class Growth>inline bool MappedVector<T, Growth>::sync()
+{
+	if (!data)return true;
+#ifdef _WIN32
+	return ::FlushViewOfFile(data, 0) && ::FlushFileBuffers(file);
+#else
+	return !::msync(data, lengthAll * sizeof(T), MS_SYNC);
+#endif
+}
+//close: unmaps and cuts the spare capacity off the file
+template<class T, class Growth>inline void MappedVector<T, Growth>::close()
+{
+	if (!isOpen())return;
+	unmap();
+#ifdef _WIN32
+	LARGE_INTEGER t;
+	t.QuadPart = (long long)length * sizeof(T);
+	::SetFilePointerEx(file, t, nullptr, FILE_BEGIN);
+	::SetEndOfFile(file);
+	::CloseHandle(file);
+	file = INVALID_HANDLE_VALUE;
+#else
+	if (::ftruncate(file, (off_t)length * sizeof(T))) {}
+	::close(file);
+	file = -1;
+#endif
+	length = 0;
+}
+//capacity
+//malloc: append a elements, the bytes are whatever the file holds there
+template<class T, class Growth>inline MappedVector<T, Growth>& MappedVector<T, Growth>::malloc(unsigned int a)
+{
+	if (!a)return *this;
+	if (length + (int)a > lengthAll)
+		reallocate(Growth::grow(lengthAll, length + a));
+	length += a;
+	return *this;
+}
+template<class T, class Growth>inline MappedVector<T, Growth>& MappedVector<T, Growth>::reserve(unsigned int a)
+{
+	if ((int)a > lengthAll)reallocate(a);
+	return *this;
+}
+template<class T, class Growth>inline MappedVector<T, Growth>& MappedVector<T, Growth>::resize(unsigned int a)
+{
+	if ((int)a > lengthAll)
+		reallocate(Growth::grow(lengthAll, a));
+	while (length < (int)a)new(data + length++)T();
+	length = a;
+	return *this;
+}
+template<class T, class Growth>inline MappedVector<T, Growth>& MappedVector<T, Growth>::reallocate(int a)
+{
+	if (a < length)a = length;
+	if (a != lengthAll)map(a);
+	return *this;
+}
+//element
+template<class T, class Growth>inline T& MappedVector<T, Growth>::begin()
+{
+	return data[0];
+}
+template<class T, class Growth>inline T& MappedVector<T, Growth>::end()
+{
+	return data[length - 1];
+}
+template<class T, class Growth>inline T* MappedVector<T, Growth>::endptr()
+{
+	return data + length - 1;
+}
+template<class T, class Growth>inline T& MappedVector<T, Growth>::operator[](unsigned int a)
+{
+	return data[a];
+}
+//add...
+template<class T, class Growth>inline MappedVector<T, Growth>& MappedVector<T, Growth>::pushBack(T const& a)
+{
+	return emplaceBack(a);
+}
+template<class T, class Growth>template<class... Args>inline MappedVector<T, Growth>& MappedVector<T, Growth>::emplaceBack(Args&&... args)
+{
+	if (lengthAll == length)
+	{
+		//args may refer to the old mapping, so build it first
+		alignas(T) unsigned char t[sizeof(T)];
+		construct((T*)t, std::forward<Args>(args)...);
+		if (!map(Growth::grow(lengthAll, length + 1)))return *this;
+		::memcpy(data + length++, t, sizeof(T));
+	}
+	else
+		construct(data + length++, std::forward<Args>(args)...);
+	return *this;
+}
+template<class T, class Growth>inline MappedVector<T, Growth>& MappedVector<T, Growth>::popBack()
+{
+	--length;
+	return *this;
+}
+template<class T, class Growth>inline MappedVector<T, Growth>& MappedVector<T, Growth>::clear()
+{
+	length = 0;
+	return *this;
+}
+//traverse
+template<class T, class Growth>template<class F>inline bool MappedVector<T, Growth>::traverse(F&& p)
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (!p(data[c1]))return false;
+	return true;
+}
+template<class T, class Growth>template<class F>inline bool MappedVector<T, Growth>::traverse(F&& p)const
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (!p((T const&)data[c1]))return false;
+	return true;
+}
+//map the first a elements of the file, unmap if a is 0
+template<class T, class Growth>inline bool MappedVector<T, Growth>::map(int a)
+{
+	if (!isOpen())return false;
+	size_t size((size_t)a * sizeof(T));
+	if (!a)
+	{
+		unmap();
+		return true;
+	}
+#ifdef _WIN32
+	//a view cannot grow on Windows: map the file again with the new size, which also extends it
+	unmap();
+	mapping = ::CreateFileMappingA(file, nullptr, PAGE_READWRITE, (DWORD)((unsigned long long)size >> 32), (DWORD)size, nullptr);
+	if (!mapping)return false;
+	data = (T*)::MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	if (!data)
+	{
+		::CloseHandle(mapping);
+		mapping = nullptr;
+		return false;
+	}
+#else
+	if (::ftruncate(file, (off_t)size))return false;
+	void* r;
+#ifdef __linux__
+	if (data)r = ::mremap(data, lengthAll * sizeof(T), size, MREMAP_MAYMOVE);
+	else r = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+#else
+	unmap();
+	r = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+#endif
+	if (r == MAP_FAILED)return false;
+	data = (T*)r;
+#endif
+	lengthAll = a;
+	return true;
+}
+template<class T, class Growth>inline void MappedVector<T, Growth>::unmap()
+{
+#ifdef _WIN32
+	if (data)::UnmapViewOfFile(data);
+	if (mapping)::CloseHandle(mapping);
+	mapping = nullptr;
+#else
+	if (data)::munmap(data, lengthAll * sizeof(T));
+#endif
+	data = nullptr;
+	lengthAll = 0;
+}
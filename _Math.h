@@ -22,7 +22,9 @@ namespace Math
 	template<class T>using mat3 = mat<T, 3, 3>;
 	template<class T>using mat4 = mat<T, 4, 4>;
 
-	template<class T, unsigned int _dim>struct vec
+	//vectors filling exactly one SSE/AVX register are aligned to it, the others keep
+	//the alignment of T so that std430 and file layouts do not change
+	template<class T, unsigned int _dim>struct alignas((sizeof(T)* _dim == 16 || sizeof(T)* _dim == 32) ? sizeof(T)* _dim : alignof(T)) vec
 	{
 		CheckNumType(T);
 		CheckDim;
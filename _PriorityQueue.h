@@ -0,0 +1,212 @@
+#pragma once
+#include <_Vector.h>
+#include <_Algorithm.h>
+
+//Heap with _arity children per node (4 keeps a node's children in one cache line for
+//small T), top() is the element no other is greater than by Compare, so Less gives a
+//max queue and Greater a min queue.
+//push returns a handle that stays valid until the element leaves the queue, it is used
+//to change the priority (update, decreaseKey) or to erase the element in O(log n).
+template<class T, class Compare = Less, unsigned int _arity = 4>struct PriorityQueue
+{
+	static_assert(_arity >= 2, "A heap node needs at least 2 children!");
+	using Handle = unsigned int;
+	struct Entry
+	{
+		T data;
+		Handle handle;
+	};
+
+	Vector<Entry>heap;
+	Vector<int>positions;			//heap index of every handle, -1 if not in the queue
+	Vector<Handle>freeHandles;
+	Compare cmp;
+
+	//Construction
+	PriorityQueue(Compare const& = Compare());
+	template<class Growth, class Allocator>PriorityQueue(Vector<T, Growth, Allocator>const&, Compare const& = Compare());
+	//capacity
+	int length()const;
+	bool empty()const;
+	PriorityQueue& reserve(unsigned int);
+	PriorityQueue& clear();
+	//element
+	T const& top()const;
+	Handle topHandle()const;
+	T const& operator[](Handle)const;
+	bool contains(Handle)const;
+	//add...
+	Handle push(T const&);
+	Handle push(T&&);
+	PriorityQueue& pop();
+	PriorityQueue& erase(Handle);
+	//priority
+	PriorityQueue& update(Handle, T const&);
+	PriorityQueue& decreaseKey(Handle, T const&);
+	//heap
+	Handle newHandle();
+	void siftUp(int);
+	void siftDown(int);
+	void place(int, Entry&&);
+};
+
+//Construction
+template<class T, class Compare, unsigned int _arity>inline PriorityQueue<T, Compare, _arity>::PriorityQueue(Compare const& _cmp)
+	:
+	heap(),
+	positions(),
+	freeHandles(),
+	cmp(_cmp)
+{
+}
+//from a Vector: handle c1 is element c1, heapified bottom up in O(n)
+template<class T, class Compare, unsigned int _arity>template<class Growth, class Allocator>inline PriorityQueue<T, Compare, _arity>::PriorityQueue(Vector<T, Growth, Allocator>const& a, Compare const& _cmp)
+	:
+	PriorityQueue(_cmp)
+{
+	reserve(a.length);
+	for (int c1(0); c1 < a.length; ++c1)
+	{
+		heap.emplaceBack(Entry{ a.data[c1], (Handle)c1 });
+		positions.pushBack(c1);
+	}
+	if (heap.length > 1)
+		for (int c1((heap.length - 2) / (int)_arity); c1 >= 0; --c1)siftDown(c1);
+}
+//capacity
+template<class T, class Compare, unsigned int _arity>inline int PriorityQueue<T, Compare, _arity>::length()const
+{
+	return heap.length;
+}
+template<class T, class Compare, unsigned int _arity>inline bool PriorityQueue<T, Compare, _arity>::empty()const
+{
+	return !heap.length;
+}
+template<class T, class Compare, unsigned int _arity>inline PriorityQueue<T, Compare, _arity>& PriorityQueue<T, Compare, _arity>::reserve(unsigned int a)
+{
+	heap.reserve(a);
+	positions.reserve(a);
+	return *this;
+}
+template<class T, class Compare, unsigned int _arity>inline PriorityQueue<T, Compare, _arity>& PriorityQueue<T, Compare, _arity>::clear()
+{
+	while (heap.length)heap.popBack();
+	while (positions.length)positions.popBack();
+	while (freeHandles.length)freeHandles.popBack();
+	return *this;
+}
+//element
+template<class T, class Compare, unsigned int _arity>inline T const& PriorityQueue<T, Compare, _arity>::top()const
+{
+	return heap.data[0].data;
+}
+template<class T, class Compare, unsigned int _arity>inline typename PriorityQueue<T, Compare, _arity>::Handle PriorityQueue<T, Compare, _arity>::topHandle()const
+{
+	return heap.data[0].handle;
+}
+template<class T, class Compare, unsigned int _arity>inline T const& PriorityQueue<T, Compare, _arity>::operator[](Handle a)const
+{
+	return heap.data[positions.data[a]].data;
+}
+template<class T, class Compare, unsigned int _arity>inline bool PriorityQueue<T, Compare, _arity>::contains(Handle a)const
+{
+	return a < (Handle)positions.length && positions.data[a] >= 0;
+}
+//add...
+template<class T, class Compare, unsigned int _arity>inline typename PriorityQueue<T, Compare, _arity>::Handle PriorityQueue<T, Compare, _arity>::push(T const& a)
+{
+	return push(T(a));
+}
+template<class T, class Compare, unsigned int _arity>inline typename PriorityQueue<T, Compare, _arity>::Handle PriorityQueue<T, Compare, _arity>::push(T&& a)
+{
+	Handle r(newHandle());
+	heap.emplaceBack(Entry{ std::move(a), r });
+	positions.data[r] = heap.length - 1;
+	siftUp(heap.length - 1);
+	return r;
+}
+template<class T, class Compare, unsigned int _arity>inline PriorityQueue<T, Compare, _arity>& PriorityQueue<T, Compare, _arity>::pop()
+{
+	return erase(heap.data[0].handle);
+}
+template<class T, class Compare, unsigned int _arity>inline PriorityQueue<T, Compare, _arity>& PriorityQueue<T, Compare, _arity>::erase(Handle a)
+{
+	int n(positions.data[a]);
+	positions.data[a] = -1;
+	freeHandles.pushBack(a);
+	if (n == heap.length - 1)
+	{
+		heap.popBack();
+		return *this;
+	}
+	//the last entry fills the hole, then goes whichever way it has to
+	place(n, std::move(heap.data[heap.length - 1]));
+	heap.popBack();
+	if (n && cmp(heap.data[(n - 1) / _arity].data, heap.data[n].data))siftUp(n);
+	else siftDown(n);
+	return *this;
+}
+//priority
+template<class T, class Compare, unsigned int _arity>inline PriorityQueue<T, Compare, _arity>& PriorityQueue<T, Compare, _arity>::update(Handle a, T const& b)
+{
+	int n(positions.data[a]);
+	heap.data[n].data = b;
+	if (n && cmp(heap.data[(n - 1) / _arity].data, heap.data[n].data))siftUp(n);
+	else siftDown(n);
+	return *this;
+}
+//decreaseKey: the element only gains priority (a smaller key in a Greater queue), O(log n) up
+template<class T, class Compare, unsigned int _arity>inline PriorityQueue<T, Compare, _arity>& PriorityQueue<T, Compare, _arity>::decreaseKey(Handle a, T const& b)
+{
+	int n(positions.data[a]);
+	heap.data[n].data = b;
+	siftUp(n);
+	return *this;
+}
+//heap
+template<class T, class Compare, unsigned int _arity>inline typename PriorityQueue<T, Compare, _arity>::Handle PriorityQueue<T, Compare, _arity>::newHandle()
+{
+	if (freeHandles.length)
+	{
+		Handle r(freeHandles.end());
+		freeHandles.popBack();
+		return r;
+	}
+	positions.pushBack(-1);
+	return positions.length - 1;
+}
+//siftUp/siftDown: the entry is held aside and the others move into the hole
+template<class T, class Compare, unsigned int _arity>inline void PriorityQueue<T, Compare, _arity>::siftUp(int n)
+{
+	Entry t(std::move(heap.data[n]));
+	while (n)
+	{
+		int p((n - 1) / _arity);
+		if (!cmp(heap.data[p].data, t.data))break;
+		place(n, std::move(heap.data[p]));
+		n = p;
+	}
+	place(n, std::move(t));
+}
+template<class T, class Compare, unsigned int _arity>inline void PriorityQueue<T, Compare, _arity>::siftDown(int n)
+{
+	Entry t(std::move(heap.data[n]));
+	while (true)
+	{
+		int c0(n * _arity + 1);
+		if (c0 >= heap.length)break;
+		int e(c0 + _arity < (unsigned int)heap.length ? c0 + _arity : heap.length);
+		int m(c0);
+		for (int c1(c0 + 1); c1 < e; ++c1)
+			if (cmp(heap.data[m].data, heap.data[c1].data))m = c1;
+		if (!cmp(t.data, heap.data[m].data))break;
+		place(n, std::move(heap.data[m]));
+		n = m;
+	}
+	place(n, std::move(t));
+}
+template<class T, class Compare, unsigned int _arity>inline void PriorityQueue<T, Compare, _arity>::place(int n, Entry&& a)
+{
+	heap.data[n] = std::move(a);
+	positions.data[heap.data[n].handle] = n;
+}
@@ -151,8 +151,7 @@ inline Vector<Math::vec3<float>>& STL::getVertices()
 }
 inline Vector<Math::vec3<float>>& STL::getVerticesRepeated()
 {
-	verticesRepeated.malloc(triangles.length * 3);
-	verticesRepeated.length = 3 * triangles.length;
+	verticesRepeated.resize(triangles.length * 3);
 	for (int c0(0); c0 < triangles.length; ++c0)
 	{
 		verticesRepeated.data[3 * c0] = triangles.data[c0].vertices.rowVec[0];
@@ -163,17 +162,17 @@ inline Vector<Math::vec3<float>>& STL::getVerticesRepeated()
 }
 inline Vector<Math::vec4<float>>& STL::getNormals()
 {
-	normals.malloc(triangles.length);
-	normals.length = triangles.length;
+	normals.resize(triangles.length);
 	for (int c0(0); c0 < triangles.length; ++c0)
 		normals.data[c0] = triangles.data[c0].normal;
 	return normals;
 }
 inline void STL::removeUseless()
 {
-	for (int c0(0); c0 < triangles.length; ++c0)
-		if (triangles[c0].getMinEdgeLength() == 0.0)
-			triangles.omit(c0--);
+	triangles.removeIf([](Triangle const& a)
+		{
+			return a.getMinEdgeLength() == 0.0;
+		});
 }
 inline double STL::getMinTriangleScale()
 {
@@ -0,0 +1,426 @@
+#pragma once
+#include <_Vector.h>
+
+//Vector with room for _inline elements inside the object itself: no heap allocation
+//until it holds more than _inline elements. Same interface as Vector.
+//Note: the buffer may live inside the object, so it is not trivially relocatable
+//and data is invalidated by moving the SmallVector itself.
+template<class T, unsigned int _inline, class Growth = DefaultGrowth, class Allocator = DefaultAllocator>struct SmallVector
+{
+	static_assert(_inline, "SmallVector needs inline room!");
+	using elementType = T;
+	static constexpr int inlineLength = _inline;
+
+	T* data;
+	int length;
+	int lengthAll;
+	alignas(T) unsigned char inlineData[_inline * sizeof(T)];
+
+	//Construction
+	SmallVector();
+	SmallVector(std::initializer_list<T>const&);
+	SmallVector(SmallVector const&);
+	SmallVector(SmallVector&&);
+	template<class Growth1, class Allocator1>SmallVector(Vector<T, Growth1, Allocator1>const&);
+	SmallVector(T const&);
+	//Destruction
+	~SmallVector();
+	//opetrator=
+	SmallVector& operator=	(SmallVector&&);
+	SmallVector& operator=	(SmallVector const&);
+	//opetrator+
+	SmallVector operator+	(SmallVector const&)const;
+	SmallVector& operator+=	(SmallVector const&);
+	//To Vector
+	Vector<T, Growth, Allocator> toVector()const;
+	//capacity
+	bool isInline()const;
+	SmallVector& malloc(unsigned int);
+	SmallVector& reserve(unsigned int);
+	SmallVector& resize(unsigned int);
+	SmallVector& shrinkToFit();
+	SmallVector& reallocate(int);
+	//element
+	T& begin();
+	T& end();
+	T* endptr();
+	T& operator[](unsigned int);
+	//Find position
+	int posFirst(T const&)const;
+	Vector<unsigned int>posAll(T const&)const;
+	//Find element
+	template<class R>T& findFirst(bool(*cmp)(T const&, R const&), R const&);
+	template<class F, class R>T& findFirst(F&&, R const&);
+	T& findFirst(T const&);
+	Vector<T*> find(T const&);
+	//add...
+	SmallVector& pushBack();
+	SmallVector& pushBack(const T&);
+	SmallVector& pushBack(T&&);
+	template<class... Args>SmallVector& emplaceBack(Args&&...);
+	SmallVector& popBack();
+	SmallVector& insert(T&&, unsigned int);
+	SmallVector& omit(unsigned int);
+	SmallVector& eraseRange(unsigned int, unsigned int);
+	SmallVector& swapErase(unsigned int);
+	template<class F>SmallVector& removeIf(F&&);
+	//traverse
+	bool traverse(bool(*p)(T&));
+	bool traverse(bool(*p)(T const&))const;
+	template<class F>bool traverse(F&&);
+	template<class F>bool traverse(F&&)const;
+	//buffer, never below the inline room
+	T* allocate(int);
+	void release(T*, int);
+};
+
+//buffer
+template<class T, unsigned int _inline, class Growth, class Allocator>inline T* SmallVector<T, _inline, Growth, Allocator>::allocate(int a)
+{
+	if (a <= (int)_inline)return (T*)inlineData;
+	return (T*)ElementAllocator<Allocator, T>::allocate(a * sizeof(T));
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline void SmallVector<T, _inline, Growth, Allocator>::release(T* a, int b)
+{
+	if (a != (T*)inlineData)ElementAllocator<Allocator, T>::deallocate(a, b * sizeof(T));
+}
+//Construction
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>::SmallVector()
+	:
+	data((T*)inlineData),
+	length(0),
+	lengthAll(_inline)
+{
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>::SmallVector(std::initializer_list<T>const& a)
+	:
+	SmallVector()
+{
+	reserve((unsigned int)a.size());
+	for (T const& d : a)
+		new(data + length++)T(d);
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>::SmallVector(SmallVector const& a)
+	:
+	SmallVector()
+{
+	reserve(a.length);
+	for (int c1 = 0; c1 < a.length; c1++)
+		new(data + c1)T(a.data[c1]);
+	length = a.length;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>::SmallVector(SmallVector&& a)
+	:
+	SmallVector()
+{
+	if (a.isInline())
+	{
+		relocate(data, a.data, a.length);
+		length = a.length;
+	}
+	else
+	{
+		data = a.data;
+		length = a.length;
+		lengthAll = a.lengthAll;
+		a.data = (T*)a.inlineData;
+		a.lengthAll = _inline;
+	}
+	a.length = 0;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>template<class Growth1, class Allocator1>inline SmallVector<T, _inline, Growth, Allocator>::SmallVector(Vector<T, Growth1, Allocator1>const& a)
+	:
+	SmallVector()
+{
+	reserve(a.length);
+	for (int c1 = 0; c1 < a.length; c1++)
+		new(data + c1)T(a.data[c1]);
+	length = a.length;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>::SmallVector(T const& a)
+	:
+	SmallVector()
+{
+	new(data)T(a);
+	length = 1;
+}
+//Destruction
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>::~SmallVector()
+{
+	for (int c1 = 0; c1 < length; c1++)(data + c1)->~T();
+	release(data, lengthAll);
+	data = (T*)inlineData;
+	length = 0;
+	lengthAll = _inline;
+}
+//opetrator=
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::operator=(SmallVector&& a)
+{
+	if (this == &a)return *this;
+	this->~SmallVector();
+	new(this)SmallVector(std::move(a));
+	return *this;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::operator=(SmallVector const& a)
+{
+	if (this == &a)return *this;
+	this->~SmallVector();
+	new(this)SmallVector(a);
+	return *this;
+}
+//operator+
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator> SmallVector<T, _inline, Growth, Allocator>::operator+(SmallVector const& a)const
+{
+	SmallVector r;
+	r.reserve(length + a.length);
+	for (int c1 = 0; c1 < length; c1++)
+		new(r.data + c1)T(data[c1]);
+	for (int c1 = 0; c1 < a.length; c1++)
+		new(r.data + c1 + length)T(a.data[c1]);
+	r.length = length + a.length;
+	return r;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::operator+=(SmallVector const& a)
+{
+	int n(a.length);
+	if (length + n > lengthAll)
+	{
+		int _lengthAll(Growth::grow(lengthAll, length + n));
+		T* tp(allocate(_lengthAll));
+		for (int c1 = 0; c1 < n; c1++)
+			new(tp + c1 + length)T(a.data[c1]);
+		relocate(tp, data, length);
+		release(data, lengthAll);
+		data = tp;
+		lengthAll = _lengthAll;
+	}
+	else
+		for (int c1 = 0; c1 < n; c1++)
+			new(data + c1 + length)T(a.data[c1]);
+	length += n;
+	return *this;
+}
+//To Vector
+template<class T, unsigned int _inline, class Growth, class Allocator>inline Vector<T, Growth, Allocator> SmallVector<T, _inline, Growth, Allocator>::toVector()const
+{
+	Vector<T, Growth, Allocator>r;
+	r.reserve(length);
+	for (int c1 = 0; c1 < length; c1++)
+		new(r.data + c1)T(data[c1]);
+	r.length = length;
+	return r;
+}
+//capacity
+template<class T, unsigned int _inline, class Growth, class Allocator>inline bool SmallVector<T, _inline, Growth, Allocator>::isInline()const
+{
+	return data == (T const*)inlineData;
+}
+//malloc: append a uninitialized elements, only meant for plain data filled in by hand
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::malloc(unsigned int a)
+{
+	if (!a)return *this;
+	if (length + (int)a > lengthAll)
+		reallocate(Growth::grow(lengthAll, length + a));
+	length += a;
+	return *this;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::reserve(unsigned int a)
+{
+	if ((int)a > lengthAll)reallocate(a);
+	return *this;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::resize(unsigned int a)
+{
+	if ((int)a > lengthAll)
+		reallocate(Growth::grow(lengthAll, a));
+	while (length < (int)a)new(data + length++)T();
+	while (length > (int)a)(data + --length)->~T();
+	return *this;
+}
+//shrinkToFit: moves back into the inline room when it fits
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::shrinkToFit()
+{
+	if (length < lengthAll && !isInline())reallocate(length);
+	return *this;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::reallocate(int a)
+{
+	if (a < (int)_inline)a = _inline;
+	if (a == lengthAll)return *this;
+	T* tp(allocate(a));
+	relocate(tp, data, length);
+	release(data, lengthAll);
+	data = tp;
+	lengthAll = a;
+	return *this;
+}
+//element
+template<class T, unsigned int _inline, class Growth, class Allocator>inline T& SmallVector<T, _inline, Growth, Allocator>::begin()
+{
+	return data[0];
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline T& SmallVector<T, _inline, Growth, Allocator>::end()
+{
+	return data[length - 1];
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline T* SmallVector<T, _inline, Growth, Allocator>::endptr()
+{
+	return data + length - 1;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline T& SmallVector<T, _inline, Growth, Allocator>::operator[](unsigned int a)
+{
+	return data[a];
+}
+//Find position
+template<class T, unsigned int _inline, class Growth, class Allocator>inline int SmallVector<T, _inline, Growth, Allocator>::posFirst(T const& a)const
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (data[c1] == a)return c1;
+	return -1;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline Vector<unsigned int> SmallVector<T, _inline, Growth, Allocator>::posAll(T const& a) const
+{
+	Vector<unsigned int>r;
+	for (int c1(0); c1 < length; c1++)
+		if (data[c1] == a)r.pushBack(c1);
+	return r;
+}
+//Find element
+template<class T, unsigned int _inline, class Growth, class Allocator>template<class R>inline T& SmallVector<T, _inline, Growth, Allocator>::findFirst(bool(*cmp)(T const&, R const&), R const& a)
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (cmp(data[c1], a))return data[c1];
+	return *(T*)NULL;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>template<class F, class R>inline T& SmallVector<T, _inline, Growth, Allocator>::findFirst(F&& cmp, R const& a)
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (cmp(data[c1], a))return data[c1];
+	return *(T*)NULL;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline T& SmallVector<T, _inline, Growth, Allocator>::findFirst(T const& a)
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (data[c1] == a)return data[c1];
+	return *(T*)NULL;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline Vector<T*> SmallVector<T, _inline, Growth, Allocator>::find(T const& a)
+{
+	Vector<T*>r;
+	for (int c1(0); c1 < length; c1++)
+		if (data[c1] == a)r.pushBack(data + c1);
+	return r;
+}
+//add...
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::pushBack()
+{
+	return emplaceBack();
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::pushBack(T const& a)
+{
+	return emplaceBack(a);
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::pushBack(T&& a)
+{
+	return emplaceBack(std::move(a));
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>template<class... Args>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::emplaceBack(Args&&... args)
+{
+	if (lengthAll == length)
+	{
+		int _lengthAll(Growth::grow(lengthAll, length + 1));
+		T* tp(allocate(_lengthAll));
+		//args may refer to elements of this, so build it before the old buffer goes away
+		construct(tp + length, std::forward<Args>(args)...);
+		relocate(tp, data, length++);
+		release(data, lengthAll);
+		data = tp;
+		lengthAll = _lengthAll;
+	}
+	else
+		construct(data + length++, std::forward<Args>(args)...);
+	return *this;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::popBack()
+{
+	(data + --length)->~T();
+	if (!isInline())
+	{
+		int t(Growth::shrink(lengthAll, length));
+		if (t != lengthAll)reallocate(t);
+	}
+	return *this;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::insert(T&& a, unsigned int b)
+{
+	if (b == (unsigned int)length)return pushBack(std::move(a));
+	if (lengthAll == length)reallocate(Growth::grow(lengthAll, length + 1));
+	relocate(data + b + 1, data + b, length - b);
+	length++;
+	new(data + b)T(std::move(a));
+	return *this;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::omit(unsigned int b)
+{
+	if (b == (unsigned int)length - 1)
+		return popBack();
+	(data + b)->~T();
+	relocate(data + b, data + b + 1, --length - b);
+	if (!isInline())
+	{
+		int t(Growth::shrink(lengthAll, length));
+		if (t != lengthAll)reallocate(t);
+	}
+	return *this;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::eraseRange(unsigned int a, unsigned int b)
+{
+	if (b > (unsigned int)length)b = length;
+	if (a >= b)return *this;
+	for (unsigned int c1 = a; c1 < b; c1++)(data + c1)->~T();
+	relocate(data + a, data + b, length - b);
+	length -= b - a;
+	return *this;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::swapErase(unsigned int a)
+{
+	(data + a)->~T();
+	relocate(data + a, data + --length, 1);
+	return *this;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>template<class F>inline SmallVector<T, _inline, Growth, Allocator>& SmallVector<T, _inline, Growth, Allocator>::removeIf(F&& p)
+{
+	int c0(0);
+	for (int c1 = 0; c1 < length; c1++)
+	{
+		if (p(data[c1]))(data + c1)->~T();
+		else relocate(data + c0++, data + c1, 1);
+	}
+	length = c0;
+	return *this;
+}
+//traverse
+template<class T, unsigned int _inline, class Growth, class Allocator>inline bool SmallVector<T, _inline, Growth, Allocator>::traverse(bool(*p)(T&))
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (!p(data[c1]))return false;
+	return true;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>inline bool SmallVector<T, _inline, Growth, Allocator>::traverse(bool(*p)(T const&))const
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (!p(data[c1]))return false;
+	return true;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>template<class F>inline bool SmallVector<T, _inline, Growth, Allocator>::traverse(F&& p)
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (!p(data[c1]))return false;
+	return true;
+}
+template<class T, unsigned int _inline, class Growth, class Allocator>template<class F>inline bool SmallVector<T, _inline, Growth, Allocator>::traverse(F&& p)const
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (!p((T const&)data[c1]))return false;
+	return true;
+}
@@ -0,0 +1,264 @@
+#pragma once
+#include <tuple>
+#include <_Vector.h>
+
+//Structure of arrays: every field lives in its own contiguous array aligned to
+//alignment bytes, so a pass over one field only streams that field.
+//Element access gives a tuple of references (works with std::get and structured bindings):
+//	SoAVector<Math::vec3<float>, float>a(particles, &Particle::position, &Particle::mass);
+//	auto [position, mass] = a[0];
+//	Math::vec3<float>* positions = a.field<0>();
+template<class... Fields>struct SoAVector
+{
+	static_assert(sizeof...(Fields), "SoAVector needs at least one field!");
+	static constexpr unsigned int fieldNum = sizeof...(Fields);
+	static constexpr size_t alignment = 64;
+	using Allocator = AlignedAllocator<alignment>;
+	using Value = std::tuple<Fields...>;
+	using Reference = std::tuple<Fields&...>;
+	using ConstReference = std::tuple<Fields const&...>;
+	template<unsigned int n>using Field = typename std::tuple_element<n, Value>::type;
+
+	std::tuple<Fields*...>data;
+	int length;
+	int lengthAll;
+
+	//Construction
+	SoAVector();
+	SoAVector(SoAVector const&);
+	SoAVector(SoAVector&&);
+	template<class S, class Growth, class Allocator1>SoAVector(Vector<S, Growth, Allocator1>const&, Fields S::*...);
+	//Destruction
+	~SoAVector();
+	//opetrator=
+	SoAVector& operator=(SoAVector&&);
+	SoAVector& operator=(SoAVector const&);
+	//To array of structs
+	template<class S>Vector<S> toAoS(Fields S::*...)const;
+	//capacity
+	SoAVector& reserve(unsigned int);
+	SoAVector& resize(unsigned int);
+	SoAVector& reallocate(int);
+	//element
+	template<unsigned int n>Field<n>* field();
+	template<unsigned int n>Field<n>const* field()const;
+	Reference operator[](unsigned int);
+	ConstReference operator[](unsigned int)const;
+	//add...
+	SoAVector& pushBack(Fields const&...);
+	SoAVector& pushBack(Value const&);
+	SoAVector& popBack();
+	SoAVector& omit(unsigned int);
+	SoAVector& swapErase(unsigned int);
+	//traverse
+	template<class F>bool traverse(F&&);
+	template<class F>bool traverse(F&&)const;
+	//per field helpers
+	template<class R>void reallocateField(R*&, int);
+	template<class R>void pushBackField(R*&, int, R const&);
+};
+
+//Construction
+template<class... Fields>inline SoAVector<Fields...>::SoAVector()
+	:
+	data(),
+	length(0),
+	lengthAll(0)
+{
+}
+template<class... Fields>inline SoAVector<Fields...>::SoAVector(SoAVector const& a)
+	:
+	SoAVector()
+{
+	reserve(a.length);
+	std::apply([&](Fields*... p)
+		{
+			std::apply([&](Fields*... q)
+				{
+					for (int c1 = 0; c1 < a.length; c1++)
+						(new(p + c1)Fields(q[c1]), ...);
+				}, a.data);
+		}, data);
+	length = a.length;
+}
+template<class... Fields>inline SoAVector<Fields...>::SoAVector(SoAVector&& a)
+	:
+	data(a.data),
+	length(a.length),
+	lengthAll(a.lengthAll)
+{
+	a.data = std::tuple<Fields*...>();
+	a.length = a.lengthAll = 0;
+}
+template<class... Fields>template<class S, class Growth, class Allocator1>inline SoAVector<Fields...>::SoAVector(Vector<S, Growth, Allocator1>const& a, Fields S::*... members)
+	:
+	SoAVector()
+{
+	reserve(a.length);
+	std::apply([&](Fields*... p)
+		{
+			for (int c1 = 0; c1 < a.length; c1++)
+				(new(p + c1)Fields(a.data[c1].*members), ...);
+		}, data);
+	length = a.length;
+}
+//Destruction
+template<class... Fields>inline SoAVector<Fields...>::~SoAVector()
+{
+	std::apply([&](Fields*... p)
+		{
+			for (int c1 = 0; c1 < length; c1++)
+				((p + c1)->~Fields(), ...);
+			(Allocator::deallocate(p, lengthAll * sizeof(Fields)), ...);
+		}, data);
+	data = std::tuple<Fields*...>();
+	length = lengthAll = 0;
+}
+//opetrator=
+template<class... Fields>inline SoAVector<Fields...>& SoAVector<Fields...>::operator=(SoAVector&& a)
+{
+	if (this == &a)return *this;
+	this->~SoAVector();
+	new(this)SoAVector(std::move(a));
+	return *this;
+}
+template<class... Fields>inline SoAVector<Fields...>& SoAVector<Fields...>::operator=(SoAVector const& a)
+{
+	if (this == &a)return *this;
+	this->~SoAVector();
+	new(this)SoAVector(a);
+	return *this;
+}
+//To array of structs
+template<class... Fields>template<class S>inline Vector<S> SoAVector<Fields...>::toAoS(Fields S::*... members)const
+{
+	Vector<S>r;
+	r.reserve(length);
+	std::apply([&](Fields*... p)
+		{
+			for (int c1 = 0; c1 < length; c1++)
+			{
+				r.emplaceBack();
+				((r.data[c1].*members = p[c1]), ...);
+			}
+		}, data);
+	return r;
+}
+//capacity
+template<class... Fields>inline SoAVector<Fields...>& SoAVector<Fields...>::reserve(unsigned int a)
+{
+	if ((int)a > lengthAll)reallocate(a);
+	return *this;
+}
+template<class... Fields>inline SoAVector<Fields...>& SoAVector<Fields...>::resize(unsigned int a)
+{
+	if ((int)a > lengthAll)reallocate(DefaultGrowth::grow(lengthAll, a));
+	std::apply([&](Fields*... p)
+		{
+			for (int c1 = length; c1 < (int)a; c1++)
+				(new(p + c1)Fields(), ...);
+			for (int c1 = a; c1 < length; c1++)
+				((p + c1)->~Fields(), ...);
+		}, data);
+	length = a;
+	return *this;
+}
+template<class... Fields>inline SoAVector<Fields...>& SoAVector<Fields...>::reallocate(int a)
+{
+	if (a < length)a = length;
+	if (a == lengthAll)return *this;
+	std::apply([&](Fields*&... p) { (reallocateField(p, a), ...); }, data);
+	lengthAll = a;
+	return *this;
+}
+//element
+template<class... Fields>template<unsigned int n>inline typename SoAVector<Fields...>::template Field<n>* SoAVector<Fields...>::field()
+{
+	return std::get<n>(data);
+}
+template<class... Fields>template<unsigned int n>inline typename SoAVector<Fields...>::template Field<n>const* SoAVector<Fields...>::field()const
+{
+	return std::get<n>(data);
+}
+template<class... Fields>inline typename SoAVector<Fields...>::Reference SoAVector<Fields...>::operator[](unsigned int a)
+{
+	return std::apply([a](Fields*... p) { return Reference(p[a]...); }, data);
+}
+template<class... Fields>inline typename SoAVector<Fields...>::ConstReference SoAVector<Fields...>::operator[](unsigned int a)const
+{
+	return std::apply([a](Fields*... p) { return ConstReference(p[a]...); }, data);
+}
+//add...
+template<class... Fields>inline SoAVector<Fields...>& SoAVector<Fields...>::pushBack(Fields const&... a)
+{
+	int _lengthAll(lengthAll == length ? DefaultGrowth::grow(lengthAll, length + 1) : lengthAll);
+	std::apply([&](Fields*&... p) { (pushBackField(p, _lengthAll, a), ...); }, data);
+	length++;
+	lengthAll = _lengthAll;
+	return *this;
+}
+template<class... Fields>inline SoAVector<Fields...>& SoAVector<Fields...>::pushBack(Value const& a)
+{
+	return std::apply([this](Fields const&... b)->SoAVector& { return pushBack(b...); }, a);
+}
+template<class... Fields>inline SoAVector<Fields...>& SoAVector<Fields...>::popBack()
+{
+	--length;
+	std::apply([&](Fields*... p) { ((p + length)->~Fields(), ...); }, data);
+	return *this;
+}
+template<class... Fields>inline SoAVector<Fields...>& SoAVector<Fields...>::omit(unsigned int a)
+{
+	--length;
+	std::apply([&](Fields*... p)
+		{
+			((p + a)->~Fields(), ...);
+			(relocate(p + a, p + a + 1, length - a), ...);
+		}, data);
+	return *this;
+}
+template<class... Fields>inline SoAVector<Fields...>& SoAVector<Fields...>::swapErase(unsigned int a)
+{
+	--length;
+	std::apply([&](Fields*... p)
+		{
+			((p + a)->~Fields(), ...);
+			(relocate(p + a, p + length, 1), ...);
+		}, data);
+	return *this;
+}
+//traverse
+template<class... Fields>template<class F>inline bool SoAVector<Fields...>::traverse(F&& p)
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (!p((*this)[c1]))return false;
+	return true;
+}
+template<class... Fields>template<class F>inline bool SoAVector<Fields...>::traverse(F&& p)const
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (!p((*this)[c1]))return false;
+	return true;
+}
+//per field helpers
+template<class... Fields>template<class R>inline void SoAVector<Fields...>::reallocateField(R*& p, int a)
+{
+	R* tp((R*)Allocator::allocate(a * sizeof(R)));
+	relocate(tp, p, length);
+	Allocator::deallocate(p, lengthAll * sizeof(R));
+	p = tp;
+}
+template<class... Fields>template<class R>inline void SoAVector<Fields...>::pushBackField(R*& p, int _lengthAll, R const& a)
+{
+	if (_lengthAll == lengthAll)
+	{
+		new(p + length)R(a);
+		return;
+	}
+	//a may be an element of this, so build it before the old array goes away
+	R* tp((R*)Allocator::allocate(_lengthAll * sizeof(R)));
+	new(tp + length)R(a);
+	relocate(tp, p, length);
+	Allocator::deallocate(p, lengthAll * sizeof(R));
+	p = tp;
+}
@@ -0,0 +1,298 @@
+#pragma once
+#include <cstring>
+#include <limits>
+#include <_TemplateMeta.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+//Bitonic sorting networks for up to 64 int, unsigned int or float keys, alone or with a
+//4 byte payload (an index into the records). The keys are padded to 8, 16, 32 or 64
+//elements with the largest key (+infinity for floats) and go through the fixed sequence
+//of compare-exchanges with no data dependent branch. Lanes of 8 (AVX2) or 4 (SSE4.1)
+//keys are compared at once, without either every compare-exchange is done on scalars.
+//Inputs holding a key equal to the padding or a NaN take an insertion sort instead.
+//Not stable.
+static constexpr int SortingNetworkMax = 64;
+
+template<class K>struct IsNetworkKey : False {};
+template<>struct IsNetworkKey<int> :True {};
+template<>struct IsNetworkKey<unsigned int> :True {};
+template<>struct IsNetworkKey<float> :True {};
+
+//NetworkLanes: the keys of one register, mask lanes are all ones or all zeros
+#if defined(__AVX2__)
+using NetworkIndex = __m256i;
+template<class K>struct NetworkLanes;
+template<>struct NetworkLanes<int>
+{
+	using V = __m256i;
+	using M = __m256i;
+	static constexpr int width = 8;
+	static V load(int const* a) { return _mm256_load_si256((__m256i const*)a); }
+	static void store(int* a, V b) { _mm256_store_si256((__m256i*)a, b); }
+	static M greater(V a, V b) { return _mm256_cmpgt_epi32(a, b); }
+	static V blend(V a, V b, M m) { return _mm256_blendv_epi8(a, b, m); }
+	static V partner(V a, __m256i n) { return _mm256_permutevar8x32_epi32(a, n); }
+};
+template<>struct NetworkLanes<unsigned int> :NetworkLanes<int>
+{
+	static V load(unsigned int const* a) { return _mm256_load_si256((__m256i const*)a); }
+	static void store(unsigned int* a, V b) { _mm256_store_si256((__m256i*)a, b); }
+	static M greater(V a, V b)
+	{
+		__m256i s(_mm256_set1_epi32(int(0x80000000u)));
+		return _mm256_cmpgt_epi32(_mm256_xor_si256(a, s), _mm256_xor_si256(b, s));
+	}
+};
+template<>struct NetworkLanes<float>
+{
+	using V = __m256;
+	using M = __m256i;
+	static constexpr int width = 8;
+	static V load(float const* a) { return _mm256_load_ps(a); }
+	static void store(float* a, V b) { _mm256_store_ps(a, b); }
+	static M greater(V a, V b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+	static V blend(V a, V b, M m) { return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(m)); }
+	static V partner(V a, __m256i n) { return _mm256_permutevar8x32_ps(a, n); }
+};
+struct NetworkMask
+{
+	using M = __m256i;
+	static M lanes() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+	static M set(int a) { return _mm256_set1_epi32(a); }
+	//b is one bit below bit 31, so a lane has it set if its and is positive. Compare
+	//equal then not sorted wrongly with GCC 12 targeting AVX-512VL/BW.
+	static M bitSet(M a, int b) { return _mm256_cmpgt_epi32(_mm256_and_si256(a, set(b)), _mm256_setzero_si256()); }
+	static M blend(M a, M b, M m) { return _mm256_blendv_epi8(a, b, m); }
+	static M bitXor(M a, M b) { return _mm256_xor_si256(a, b); }
+	static M partner(M a, M n) { return _mm256_permutevar8x32_epi32(a, n); }
+	static M load(void const* a) { return _mm256_load_si256((__m256i const*)a); }
+	static void store(void* a, M b) { _mm256_store_si256((__m256i*)a, b); }
+};
+#elif defined(__SSE4_1__)
+using NetworkIndex = __m128i;
+template<class K>struct NetworkLanes;
+template<>struct NetworkLanes<int>
+{
+	using V = __m128i;
+	using M = __m128i;
+	static constexpr int width = 4;
+	static V load(int const* a) { return _mm_load_si128((__m128i const*)a); }
+	static void store(int* a, V b) { _mm_store_si128((__m128i*)a, b); }
+	static M greater(V a, V b) { return _mm_cmpgt_epi32(a, b); }
+	static V blend(V a, V b, M m) { return _mm_blendv_epi8(a, b, m); }
+	//lane l ^ n, n is 1 or 2
+	static V partner(V a, int n) { return n == 1 ? _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)) : _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)); }
+};
+template<>struct NetworkLanes<unsigned int> :NetworkLanes<int>
+{
+	static V load(unsigned int const* a) { return _mm_load_si128((__m128i const*)a); }
+	static void store(unsigned int* a, V b) { _mm_store_si128((__m128i*)a, b); }
+	static M greater(V a, V b)
+	{
+		__m128i s(_mm_set1_epi32(int(0x80000000u)));
+		return _mm_cmpgt_epi32(_mm_xor_si128(a, s), _mm_xor_si128(b, s));
+	}
+};
+template<>struct NetworkLanes<float>
+{
+	using V = __m128;
+	using M = __m128i;
+	static constexpr int width = 4;
+	static V load(float const* a) { return _mm_load_ps(a); }
+	static void store(float* a, V b) { _mm_store_ps(a, b); }
+	static M greater(V a, V b) { return _mm_castps_si128(_mm_cmpgt_ps(a, b)); }
+	static V blend(V a, V b, M m) { return _mm_blendv_ps(a, b, _mm_castsi128_ps(m)); }
+	static V partner(V a, int n) { return n == 1 ? _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)) : _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 3, 2)); }
+};
+struct NetworkMask
+{
+	using M = __m128i;
+	static M lanes() { return _mm_setr_epi32(0, 1, 2, 3); }
+	static M set(int a) { return _mm_set1_epi32(a); }
+	static M bitSet(M a, int b) { return _mm_cmpgt_epi32(_mm_and_si128(a, set(b)), _mm_setzero_si128()); }
+	static M blend(M a, M b, M m) { return _mm_blendv_epi8(a, b, m); }
+	static M bitXor(M a, M b) { return _mm_xor_si128(a, b); }
+	static M partner(M a, int n) { return n == 1 ? _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)) : _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)); }
+	static M load(void const* a) { return _mm_load_si128((__m128i const*)a); }
+	static void store(void* a, M b) { _mm_store_si128((__m128i*)a, b); }
+};
+#else
+using NetworkIndex = unsigned int;
+template<class K>struct NetworkLanes
+{
+	using V = K;
+	using M = bool;
+	static constexpr int width = 1;
+	static V load(K const* a) { return *a; }
+	static void store(K* a, V b) { *a = b; }
+	static M greater(V a, V b) { return a > b; }
+	static V blend(V a, V b, M m) { return m ? b : a; }
+};
+struct NetworkMask
+{
+	using M = unsigned int;
+	static M blend(M a, M b, bool m) { return m ? b : a; }
+	static M load(void const* a) { return *(unsigned int const*)a; }
+	static void store(void* a, M b) { *(unsigned int*)a = b; }
+};
+#endif
+//without SIMD lanes the network does more compares than an insertion sort saves branches
+static constexpr bool SortingNetworkSimd = NetworkLanes<int>::width > 1;
+
+//bitonicNetwork: sorts keys[0, n) (and moves values with them if _values), n is a power
+//of two that is a multiple of the lane width, both arrays aligned to 32
+template<class K, bool _values>inline void bitonicNetwork(K* keys, unsigned int* values, int n)
+{
+	using L = NetworkLanes<K>;
+	using V = typename L::V;
+	using M = typename L::M;
+	static constexpr int w = L::width;
+	V v[SortingNetworkMax / w];
+	NetworkIndex x[SortingNetworkMax / w];
+	int regs(n / w);
+	for (int c0(0); c0 < regs; ++c0)
+	{
+		v[c0] = L::load(keys + c0 * w);
+		if constexpr (_values)x[c0] = NetworkMask::load(values + c0 * w);
+	}
+	for (int k(2); k <= n; k <<= 1)
+		for (int j(k >> 1); j; j >>= 1)
+		{
+			if (j >= w)
+			{
+				//registers r and r ^ j / w, descending where bit k of the index is set
+				for (int c0(0); c0 < regs; ++c0)
+				{
+					int c1(c0 ^ (j / w));
+					if (c1 < c0)continue;
+					M s(((c0 * w) & k) ? L::greater(v[c1], v[c0]) : L::greater(v[c0], v[c1]));
+					V a(L::blend(v[c0], v[c1], s));
+					v[c1] = L::blend(v[c1], v[c0], s);
+					v[c0] = a;
+					if constexpr (_values)
+					{
+						NetworkIndex b(NetworkMask::blend(x[c0], x[c1], s));
+						x[c1] = NetworkMask::blend(x[c1], x[c0], s);
+						x[c0] = b;
+					}
+				}
+			}
+#if defined(__AVX2__) || defined(__SSE4_1__)
+			else
+			{
+				//lanes l and l ^ j of one register: the upper lane of an ascending pair
+				//(or the lower of a descending one) keeps the larger key
+				using N = NetworkMask;
+#if defined(__AVX2__)
+				__m256i p(N::bitXor(N::lanes(), N::set(j)));
+#else
+				int p(j);
+#endif
+				typename N::M hi(N::bitSet(N::lanes(), j));
+				for (int c0(0); c0 < regs; ++c0)
+				{
+					typename N::M desc(k < w ? N::bitSet(N::lanes(), k) : N::set(((c0 * w) & k) ? -1 : 0));
+					typename N::M m(N::bitXor(hi, desc));
+					V o(L::partner(v[c0], p));
+					M s(N::blend(L::greater(v[c0], o), L::greater(o, v[c0]), m));
+					v[c0] = L::blend(v[c0], o, s);
+					if constexpr (_values)x[c0] = N::blend(x[c0], N::partner(x[c0], p), s);
+				}
+			}
+#endif
+		}
+	for (int c0(0); c0 < regs; ++c0)
+	{
+		L::store(keys + c0 * w, v[c0]);
+		if constexpr (_values)NetworkMask::store(values + c0 * w, x[c0]);
+	}
+}
+template<class K>inline int networkSize(int n)
+{
+	int r(NetworkLanes<K>::width < 8 ? 8 : NetworkLanes<K>::width);
+	while (r < n)r <<= 1;
+	return r;
+}
+//networkPad: the key the input is padded with, above every key the network may sort
+template<class K>inline K networkPad()
+{
+	if constexpr (std::numeric_limits<K>::has_infinity)return std::numeric_limits<K>::infinity();
+	else return std::numeric_limits<K>::max();
+}
+//networkPadSafe: true if no key of a[0, n) can tie with the padding (or is a NaN), so the
+//first n outputs are the real keys; a tie could hand a real key's value to a pad slot
+template<class K>inline bool networkPadSafe(K const* a, int n)
+{
+	K pad(networkPad<K>());
+	for (int c0(0); c0 < n; ++c0)
+		if (!(a[c0] < pad))return false;
+	return true;
+}
+//networkInsertionSort: fallback for keys that are not networkPadSafe
+template<class K, bool _values>inline void networkInsertionSort(K* keys, unsigned int* values, int n)
+{
+	for (int c0(1); c0 < n; ++c0)
+	{
+		K k(keys[c0]);
+		unsigned int v(_values ? values[c0] : 0);
+		int c1(c0);
+		for (; c1 && k < keys[c1 - 1]; --c1)
+		{
+			keys[c1] = keys[c1 - 1];
+			if constexpr (_values)values[c1] = values[c1 - 1];
+		}
+		keys[c1] = k;
+		if constexpr (_values)values[c1] = v;
+	}
+}
+//sortingNetwork: sorts a[0, n), n <= SortingNetworkMax
+template<class K>inline void sortingNetwork(K* const a, int n)
+{
+	static_assert(IsNetworkKey<K>::value, "sortingNetwork sorts int, unsigned int or float keys!");
+	if (n < 2)return;
+	if (!networkPadSafe(a, n))
+	{
+		networkInsertionSort<K, false>(a, nullptr, n);
+		return;
+	}
+	alignas(32) K t[SortingNetworkMax];
+	int m(networkSize<K>(n));
+	for (int c0(0); c0 < n; ++c0)t[c0] = a[c0];
+	for (int c0(n); c0 < m; ++c0)t[c0] = networkPad<K>();
+	bitonicNetwork<K, false>(t, nullptr, m);
+	for (int c0(0); c0 < n; ++c0)a[c0] = t[c0];
+}
+//sortingNetwork: sorts keys[0, n) and moves the 4 byte values[0, n) with them
+template<class K, class I>inline void sortingNetwork(K* const keys, I* const values, int n)
+{
+	static_assert(IsNetworkKey<K>::value, "sortingNetwork sorts int, unsigned int or float keys!");
+	static_assert(sizeof(I) == 4 && __is_trivially_copyable(I), "sortingNetwork moves 4 byte values!");
+	if (n < 2)return;
+	alignas(32) K t[SortingNetworkMax];
+	alignas(32) unsigned int u[SortingNetworkMax];
+	int m(networkSize<K>(n));
+	for (int c0(0); c0 < n; ++c0)
+	{
+		t[c0] = keys[c0];
+		::memcpy(u + c0, values + c0, 4);
+	}
+	if (!networkPadSafe(t, n))networkInsertionSort<K, true>(t, u, n);
+	else
+	{
+		for (int c0(n); c0 < m; ++c0)
+		{
+			t[c0] = networkPad<K>();
+			u[c0] = 0;
+		}
+		bitonicNetwork<K, true>(t, u, m);
+	}
+	for (int c0(0); c0 < n; ++c0)
+	{
+		keys[c0] = t[c0];
+		::memcpy(values + c0, u + c0, 4);
+	}
+}
@@ -0,0 +1,238 @@
+#pragma once
+#include <_Vector.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//Vector made of segments of _first, 2 * _first, 4 * _first... elements.
+//Growing only adds a segment, so elements never move and pointers to them stay valid
+//(parent links in trees, handles...), while operator[] is still O(1).
+template<class T, unsigned int _first = 4, class Allocator = DefaultAllocator>struct StableVector
+{
+	static_assert(_first && !(_first & (_first - 1)), "First segment length must be a power of 2!");
+	using elementType = T;
+
+	Vector<T*, DefaultGrowth, Allocator>segments;
+	int length;
+	int lengthAll;
+
+	//Construction
+	StableVector();
+	StableVector(std::initializer_list<T>const&);
+	StableVector(StableVector const&);
+	StableVector(StableVector&&);
+	//Destruction
+	~StableVector();
+	//opetrator=
+	StableVector& operator=	(StableVector&&);
+	StableVector& operator=	(StableVector const&);
+	//capacity
+	StableVector& reserve(unsigned int);
+	StableVector& clear();
+	//element
+	T& begin();
+	T& end();
+	T& operator[](unsigned int);
+	T const& operator[](unsigned int)const;
+	//Find position
+	int posFirst(T const&)const;
+	Vector<unsigned int>posAll(T const&)const;
+	//Find element
+	template<class F, class R>T& findFirst(F&&, R const&);
+	T& findFirst(T const&);
+	Vector<T*> find(T const&);
+	//add...
+	StableVector& pushBack(T const&);
+	StableVector& pushBack(T&&);
+	template<class... Args>StableVector& emplaceBack(Args&&...);
+	StableVector& popBack();
+	//traverse
+	template<class F>bool traverse(F&&);
+	template<class F>bool traverse(F&&)const;
+	//segment and offset of an index
+	static unsigned int highestBit(unsigned int);
+	static unsigned int segmentOf(unsigned int, unsigned int&);
+};
+
+//Construction
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>::StableVector()
+	:
+	segments(),
+	length(0),
+	lengthAll(0)
+{
+}
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>::StableVector(std::initializer_list<T>const& a)
+	:
+	StableVector()
+{
+	reserve((unsigned int)a.size());
+	for (T const& d : a)emplaceBack(d);
+}
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>::StableVector(StableVector const& a)
+	:
+	StableVector()
+{
+	reserve(a.length);
+	for (int c1 = 0; c1 < a.length; c1++)emplaceBack(a[c1]);
+}
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>::StableVector(StableVector&& a)
+	:
+	segments(std::move(a.segments)),
+	length(a.length),
+	lengthAll(a.lengthAll)
+{
+	a.length = a.lengthAll = 0;
+}
+//Destruction
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>::~StableVector()
+{
+	clear();
+	for (int c1 = 0; c1 < segments.length; c1++)
+		ElementAllocator<Allocator, T>::deallocate(segments.data[c1], (_first << c1) * sizeof(T));
+	lengthAll = 0;
+}
+//opetrator=
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>& StableVector<T, _first, Allocator>::operator=(StableVector&& a)
+{
+	if (this == &a)return *this;
+	this->~StableVector();
+	new(this)StableVector(std::move(a));
+	return *this;
+}
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>& StableVector<T, _first, Allocator>::operator=(StableVector const& a)
+{
+	if (this == &a)return *this;
+	this->~StableVector();
+	new(this)StableVector(a);
+	return *this;
+}
+//capacity
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>& StableVector<T, _first, Allocator>::reserve(unsigned int a)
+{
+	while (lengthAll < (int)a)
+	{
+		segments.pushBack((T*)ElementAllocator<Allocator, T>::allocate((_first << segments.length) * sizeof(T)));
+		lengthAll += _first << (segments.length - 1);
+	}
+	return *this;
+}
+//clear: destroys the elements but keeps the segments
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>& StableVector<T, _first, Allocator>::clear()
+{
+	while (length)popBack();
+	return *this;
+}
+//element
+template<class T, unsigned int _first, class Allocator>inline T& StableVector<T, _first, Allocator>::begin()
+{
+	return segments.data[0][0];
+}
+template<class T, unsigned int _first, class Allocator>inline T& StableVector<T, _first, Allocator>::end()
+{
+	return (*this)[length - 1];
+}
+template<class T, unsigned int _first, class Allocator>inline T& StableVector<T, _first, Allocator>::operator[](unsigned int a)
+{
+	unsigned int n;
+	unsigned int k(segmentOf(a, n));
+	return segments.data[k][n];
+}
+template<class T, unsigned int _first, class Allocator>inline T const& StableVector<T, _first, Allocator>::operator[](unsigned int a)const
+{
+	unsigned int n;
+	unsigned int k(segmentOf(a, n));
+	return segments.data[k][n];
+}
+//Find position
+template<class T, unsigned int _first, class Allocator>inline int StableVector<T, _first, Allocator>::posFirst(T const& a)const
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if ((*this)[c1] == a)return c1;
+	return -1;
+}
+template<class T, unsigned int _first, class Allocator>inline Vector<unsigned int> StableVector<T, _first, Allocator>::posAll(T const& a)const
+{
+	Vector<unsigned int>r;
+	for (int c1(0); c1 < length; c1++)
+		if ((*this)[c1] == a)r.pushBack(c1);
+	return r;
+}
+//Find element
+template<class T, unsigned int _first, class Allocator>template<class F, class R>inline T& StableVector<T, _first, Allocator>::findFirst(F&& cmp, R const& a)
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (cmp((*this)[c1], a))return (*this)[c1];
+	return *(T*)NULL;
+}
+template<class T, unsigned int _first, class Allocator>inline T& StableVector<T, _first, Allocator>::findFirst(T const& a)
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if ((*this)[c1] == a)return (*this)[c1];
+	return *(T*)NULL;
+}
+template<class T, unsigned int _first, class Allocator>inline Vector<T*> StableVector<T, _first, Allocator>::find(T const& a)
+{
+	Vector<T*>r;
+	for (int c1(0); c1 < length; c1++)
+		if ((*this)[c1] == a)r.pushBack(&(*this)[c1]);
+	return r;
+}
+//add...
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>& StableVector<T, _first, Allocator>::pushBack(T const& a)
+{
+	return emplaceBack(a);
+}
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>& StableVector<T, _first, Allocator>::pushBack(T&& a)
+{
+	return emplaceBack(std::move(a));
+}
+//emplaceBack: the element is built at its final address, so it may keep pointers to itself
+template<class T, unsigned int _first, class Allocator>template<class... Args>inline StableVector<T, _first, Allocator>& StableVector<T, _first, Allocator>::emplaceBack(Args&&... args)
+{
+	reserve(length + 1);
+	construct(&(*this)[length], std::forward<Args>(args)...);
+	++length;
+	return *this;
+}
+template<class T, unsigned int _first, class Allocator>inline StableVector<T, _first, Allocator>& StableVector<T, _first, Allocator>::popBack()
+{
+	(*this)[--length].~T();
+	return *this;
+}
+//traverse
+template<class T, unsigned int _first, class Allocator>template<class F>inline bool StableVector<T, _first, Allocator>::traverse(F&& p)
+{
+	int c0(0);
+	for (int c1 = 0; c0 < length; c1++)
+		for (int c2 = 0; c2 < (int)(_first << c1) && c0 < length; c2++, c0++)
+			if (!p(segments.data[c1][c2]))return false;
+	return true;
+}
+template<class T, unsigned int _first, class Allocator>template<class F>inline bool StableVector<T, _first, Allocator>::traverse(F&& p)const
+{
+	int c0(0);
+	for (int c1 = 0; c0 < length; c1++)
+		for (int c2 = 0; c2 < (int)(_first << c1) && c0 < length; c2++, c0++)
+			if (!p((T const&)segments.data[c1][c2]))return false;
+	return true;
+}
+//segment and offset of an index
+template<class T, unsigned int _first, class Allocator>inline unsigned int StableVector<T, _first, Allocator>::highestBit(unsigned int a)
+{
+#ifdef _MSC_VER
+	unsigned long r;
+	_BitScanReverse(&r, a);
+	return r;
+#else
+	return 31 - __builtin_clz(a);
+#endif
+}
+//segment k starts at index _first * (2^k - 1)
+template<class T, unsigned int _first, class Allocator>inline unsigned int StableVector<T, _first, Allocator>::segmentOf(unsigned int a, unsigned int& n)
+{
+	unsigned int j(a + _first);
+	unsigned int k(highestBit(j) - highestBit(_first));
+	n = j - (_first << k);
+	return k;
+}
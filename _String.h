@@ -5,6 +5,7 @@
 #include <cstdlib>
 #include <_Vector.h>
 #include <_TemplateMeta.h>
+#include <_Allocator.h>
 
 /*
 	To add:
@@ -18,7 +19,7 @@ static bool wchar_tInited(false);
 static void wchar_tInit();
 //Support char and wchar_t in Windows only!
 //Note: String<wchar_t> stores Chinese charactors in unicode!
-template<class T>struct String
+template<class T, class Allocator = DefaultAllocator>struct String
 {
 	static_assert(CharType<T>::value, "Wrong CharType!");
 	template<class R>static T* transfer(R const*);
@@ -29,9 +30,9 @@ template<class T>struct String
 
 	//Construction
 	String();
-	template<class R>String(String<R>const&);
-	String(String<T>const&);
-	String(String<T>&&);
+	template<class R, class Allocator1>String(String<R, Allocator1>const&);
+	String(String<T, Allocator>const&);
+	String(String<T, Allocator>&&);
 	template<class R>String(R const*);
 	String(T const*);
 	String(T*&, unsigned int, unsigned int);
@@ -42,34 +43,36 @@ template<class T>struct String
 	operator T* ();
 	operator T const* ()const;
 	//operator=
-	template<class R>String<T>& operator=(String<R>const&);
-	String<T>& operator=(String<T>const&);
+	template<class R, class Allocator1>String<T, Allocator>& operator=(String<R, Allocator1>const&);
+	String<T, Allocator>& operator=(String<T, Allocator>const&);
 	//operator==
-	template<class R>bool operator==(String<R>const&)const;
+	template<class R, class Allocator1>bool operator==(String<R, Allocator1>const&)const;
 	template<class R>bool operator==(R const*)const;
 	//operator+
-	template<class R>auto operator+(String<R>const&)const;
+	template<class R, class Allocator1>auto operator+(String<R, Allocator1>const&)const;
 	template<class R>auto operator+(R const*)const;
 	//operator+=
-	template<class R>auto& operator+=(String<R>const&);
+	template<class R, class Allocator1>auto& operator+=(String<R, Allocator1>const&);
 	template<class R>auto& operator+=(R const*);
 	template<class R>auto& operator+=(R*);
 	template<class R>auto& operator+=(R);
 	//findFirst
-	template<class R>int findFirst(String<R>const&);
+	template<class R, class Allocator1>int findFirst(String<R, Allocator1>const&);
 	int* getNext()const;
-	int KMP(String<T>const&)const;
-	template<class R>int findFirstKMP(String<R>const&);
+	template<class Allocator1>int KMP(String<T, Allocator1>const&)const;
+	template<class R, class Allocator1>int findFirstKMP(String<R, Allocator1>const&);
 	template<class R>int findFirst(R const*);
 	//find
-	template<class R>Vector<int>find(String<R>const&)const;
+	template<class R, class Allocator1>Vector<int>find(String<R, Allocator1>const&)const;
 	template<class R>Vector<int>find(R const*)const;
 	//truncate
-	String<T>truncate(int, int)const;
+	String<T, Allocator>truncate(int, int)const;
 	//print
 	void print()const;
 	void printInfo()const;
 };
+//String only owns a pointer to its buffer, so it can be moved by memcpy
+template<class T, class Allocator>struct IsTriviallyRelocatable<String<T, Allocator>> :True {};
 
 
 inline void wchar_tInit()
@@ -85,7 +88,7 @@ inline unsigned int sweepStr(char const* _str, char const* _mode)
 	return t;
 }
 //transfer
-template<class T>template<class R>	inline T* String<T>::transfer(R const* a)
+template<class T, class Allocator>template<class R>	inline T* String<T, Allocator>::transfer(R const* a)
 {
 	static_assert(!IsSameType<T, R>::value, "Cannot tranfer same CharType!");
 	static_assert(CharType<R>::value, "Wrong CharType!");
@@ -94,22 +97,22 @@ template<class T>template<class R>	inline T* String<T>::transfer(R const* a)
 	{
 		wchar_t* temp;
 		unsigned int tempLength((unsigned int)::mbstowcs(nullptr, a, 0) + 1);
-		::mbstowcs(temp = (wchar_t*)::malloc(tempLength << 1), a, tempLength);
+		::mbstowcs(temp = (wchar_t*)Allocator::allocate(tempLength << 1), a, tempLength);
 		return temp;
 	}
 	else
 	{
 		char* temp;
 		unsigned int tempLength((unsigned int)::wcstombs(nullptr, a, 0) + 1);
-		::wcstombs(temp = (char*)::malloc(tempLength), a, tempLength);
+		::wcstombs(temp = (char*)Allocator::allocate(tempLength), a, tempLength);
 		return temp;
 	}
 }
 //Construction
-template<class T>					inline String<T>::String() :data(nullptr), length(0), lengthAll(0)
+template<class T, class Allocator>					inline String<T, Allocator>::String() :data(nullptr), length(0), lengthAll(0)
 {
 }
-template<class T>template<class R>	inline String<T>::String(String<R>const& a)
+template<class T, class Allocator>template<class R, class Allocator1>	inline String<T, Allocator>::String(String<R, Allocator1>const& a)
 {
 	if (!a.data)
 	{
@@ -117,22 +120,30 @@ template<class T>template<class R>	inline String<T>::String(String<R>const& a)
 		length = lengthAll = 0;
 		return;
 	}
-	if constexpr (IsSameType<T, char>::value)
+	if constexpr (IsSameType<T, R>::value)
+	{
+		//same CharType from another allocator
+		length = a.length;
+		lengthAll = a.lengthAll;
+		data = (T*)Allocator::allocate(lengthAll * sizeof(T));
+		memcpy(data, a.data, (length + 1) * sizeof(T));
+	}
+	else if constexpr (IsSameType<T, char>::value)
 	{
 		length = (unsigned int)::wcstombs(nullptr, a.data, 0);
 		lengthAll = 1;
 		while (lengthAll < length + 1)lengthAll <<= 1;
-		::wcstombs(data = (T*)::malloc(lengthAll), a.data, length + 1);
+		::wcstombs(data = (T*)Allocator::allocate(lengthAll), a.data, length + 1);
 	}
 	else
 	{
 		length = (unsigned int)::mbstowcs(nullptr, a.data, 0);
 		lengthAll = 1;
 		while (lengthAll < length + 1)lengthAll <<= 1;
-		::mbstowcs(data = (T*)::malloc(lengthAll << 1), a.data, length + 1);
+		::mbstowcs(data = (T*)Allocator::allocate(lengthAll << 1), a.data, length + 1);
 	}
 }
-template<class T>					inline String<T>::String(String<T>const& a)
+template<class T, class Allocator>					inline String<T, Allocator>::String(String<T, Allocator>const& a)
 {
 	if (&a == this)return;
 	if (!a.data)
@@ -145,18 +156,18 @@ template<class T>					inline String<T>::String(String<T>const& a)
 	{
 		length = a.length;
 		lengthAll = a.lengthAll;
-		data = (T*)::malloc(lengthAll);
+		data = (T*)Allocator::allocate(lengthAll);
 		memcpy(data, a.data, length + 1);
 	}
 	else
 	{
 		length = a.length;
 		lengthAll = a.lengthAll;
-		data = (T*)::malloc(lengthAll << 1);
+		data = (T*)Allocator::allocate(lengthAll << 1);
 		memcpy(data, a.data, (length + 1) << 1);
 	}
 }
-template<class T>					inline String<T>::String(String<T> && a)
+template<class T, class Allocator>					inline String<T, Allocator>::String(String<T, Allocator> && a)
 	:
 	data(a.data),
 	length(a.length),
@@ -164,7 +175,7 @@ template<class T>					inline String<T>::String(String<T> && a)
 {
 	a.data = nullptr;
 }
-template<class T>template<class R>	inline String<T>::String(R const* a)
+template<class T, class Allocator>template<class R>	inline String<T, Allocator>::String(R const* a)
 {
 	static_assert(CharType<T>::value, "Wrong CharType!");
 	if (!a)
@@ -178,24 +189,24 @@ template<class T>template<class R>	inline String<T>::String(R const* a)
 		length = (unsigned int)::wcstombs(nullptr, a, 0);
 		lengthAll = 1;
 		while (lengthAll < length + 1)lengthAll <<= 1;
-		::wcstombs(data = (T*)::malloc(lengthAll), a, length + 1);
+		::wcstombs(data = (T*)Allocator::allocate(lengthAll), a, length + 1);
 	}
 	else
 	{
 		length = (unsigned int)::mbstowcs(nullptr, a, 0);
 		lengthAll = 1;
 		while (lengthAll < length + 1)lengthAll <<= 1;
-		::mbstowcs(data = (T*)::malloc(lengthAll << 1), a, length + 1);
+		::mbstowcs(data = (T*)Allocator::allocate(lengthAll << 1), a, length + 1);
 	}
 }
-template<class T>					inline String<T>::String(T const* a)
+template<class T, class Allocator>					inline String<T, Allocator>::String(T const* a)
 {
 	if constexpr (IsSameType<T, char>::value)
 	{
 		length = (unsigned int)::strlen(a);
 		lengthAll = 1;
 		while (lengthAll < length + 1)lengthAll <<= 1;
-		data = (T*)::malloc(lengthAll);
+		data = (T*)Allocator::allocate(lengthAll);
 		memcpy(data, a, length + 1);
 	}
 	else
@@ -203,11 +214,11 @@ template<class T>					inline String<T>::String(T const* a)
 		length = (unsigned int)::wcslen(a);
 		lengthAll = 1;
 		while (lengthAll < length + 1)lengthAll <<= 1;
-		data = (T*)::malloc(lengthAll << 1);
+		data = (T*)Allocator::allocate(lengthAll << 1);
 		memcpy(data, a, (length + 1) << 1);
 	}
 }
-template<class T>					inline String<T>::String(T * &a, unsigned int _length, unsigned int _lengthAll)
+template<class T, class Allocator>					inline String<T, Allocator>::String(T * &a, unsigned int _length, unsigned int _lengthAll)
 {
 	if (_length)
 	{
@@ -219,7 +230,7 @@ template<class T>					inline String<T>::String(T * &a, unsigned int _length, uns
 		{
 			lengthAll = 1;
 			while (lengthAll < length + 1)lengthAll <<= 1;
-			data = (T*)::realloc(data, lengthAll * sizeof(T));
+			data = (T*)Allocator::reallocate(data, length * sizeof(T), lengthAll * sizeof(T));
 			data[length] = 0;
 		}
 	}
@@ -234,12 +245,12 @@ template<class T>					inline String<T>::String(T * &a, unsigned int _length, uns
 		{
 			lengthAll = 1;
 			while (lengthAll < length + 1)lengthAll <<= 1;
-			data = (T*)::realloc(data, lengthAll * sizeof(T));
+			data = (T*)Allocator::reallocate(data, length * sizeof(T), lengthAll * sizeof(T));
 			data[length] = 0;
 		}
 	}
 }
-template<class T>					inline String<T>::String(T * &&a, unsigned int _length, unsigned int _lengthAll)
+template<class T, class Allocator>					inline String<T, Allocator>::String(T * &&a, unsigned int _length, unsigned int _lengthAll)
 {
 	if (_length)
 	{
@@ -251,7 +262,7 @@ template<class T>					inline String<T>::String(T * &&a, unsigned int _length, un
 		{
 			lengthAll = 1;
 			while (lengthAll < length + 1)lengthAll <<= 1;
-			data = (T*)::realloc(data, lengthAll * sizeof(T));
+			data = (T*)Allocator::reallocate(data, length * sizeof(T), lengthAll * sizeof(T));
 			data[length] = 0;
 		}
 	}
@@ -266,44 +277,44 @@ template<class T>					inline String<T>::String(T * &&a, unsigned int _length, un
 		{
 			lengthAll = 1;
 			while (lengthAll < length + 1)lengthAll <<= 1;
-			data = (T*)::realloc(data, lengthAll * sizeof(T));
+			data = (T*)Allocator::reallocate(data, length * sizeof(T), lengthAll * sizeof(T));
 			data[length] = 0;
 		}
 	}
 }
 //Destrucion
-template<class T>					inline String<T>::~String()
+template<class T, class Allocator>					inline String<T, Allocator>::~String()
 {
-	if (data)::free(data);
+	if (data)Allocator::deallocate(data, lengthAll * sizeof(T));
 	data = nullptr;
 }
 //operator T*()
-template<class T>					inline String<T>::operator T* ()
+template<class T, class Allocator>					inline String<T, Allocator>::operator T* ()
 {
 	return data;
 }
-template<class T>inline String<T>::operator T const* ()const
+template<class T, class Allocator>inline String<T, Allocator>::operator T const* ()const
 {
 	return (T const*)data;
 }
 //operator=
-template<class T>template<class R>	inline String<T>& String<T>::operator=(String<R>const& a)
+template<class T, class Allocator>template<class R, class Allocator1>	inline String<T, Allocator>& String<T, Allocator>::operator=(String<R, Allocator1>const& a)
 {
-	if (data)::free(data);
+	if (data)Allocator::deallocate(data, lengthAll * sizeof(T));
 	if constexpr (IsSameType<T, R>::value)
 	{
 		if constexpr (IsSameType<T, char>::value)
 		{
 			length = a.length;
 			lengthAll = a.lengthAll;
-			data = (T*)::malloc(lengthAll);
+			data = (T*)Allocator::allocate(lengthAll);
 			memcpy(data, a.data, length + 1);
 		}
 		else
 		{
 			length = a.length;
 			lengthAll = a.lengthAll;
-			data = (T*)::malloc(lengthAll << 1);
+			data = (T*)Allocator::allocate(lengthAll << 1);
 			memcpy(data, a.data, (length + 1) << 1);
 		}
 		return *this;
@@ -315,39 +326,39 @@ template<class T>template<class R>	inline String<T>& String<T>::operator=(String
 			length = (unsigned int)::wcstombs(nullptr, a.data, 0);
 			lengthAll = 1;
 			while (lengthAll < length + 1)lengthAll <<= 1;
-			::wcstombs(data = (T*)::malloc(lengthAll), a.data, length + 1);
+			::wcstombs(data = (T*)Allocator::allocate(lengthAll), a.data, length + 1);
 		}
 		else
 		{
 			length = (unsigned int)::mbstowcs(nullptr, a.data, 0);
 			lengthAll = 1;
 			while (lengthAll < length + 1)lengthAll <<= 1;
-			::mbstowcs(data = (T*)::malloc(lengthAll << 1), a.data, length + 1);
+			::mbstowcs(data = (T*)Allocator::allocate(lengthAll << 1), a.data, length + 1);
 		}
 	}
 	return *this;
 }
-template<class T>					inline String<T> & String<T>::operator=(String<T>const& a)
+template<class T, class Allocator>					inline String<T, Allocator> & String<T, Allocator>::operator=(String<T, Allocator>const& a)
 {
-	if (data)::free(data);
+	if (data)Allocator::deallocate(data, lengthAll * sizeof(T));
 	if constexpr (IsSameType<T, char>::value)
 	{
 		length = a.length;
 		lengthAll = a.lengthAll;
-		data = (T*)::malloc(lengthAll);
+		data = (T*)Allocator::allocate(lengthAll);
 		memcpy(data, a.data, length + 1);
 	}
 	else
 	{
 		length = a.length;
 		lengthAll = a.lengthAll;
-		data = (T*)::malloc(lengthAll << 1);
+		data = (T*)Allocator::allocate(lengthAll << 1);
 		memcpy(data, a.data, (length + 1) << 1);
 	}
 	return *this;
 }
 //operator==
-template<class T>template<class R>	inline bool String<T>::operator==(String<R>const& a)const
+template<class T, class Allocator>template<class R, class Allocator1>	inline bool String<T, Allocator>::operator==(String<R, Allocator1>const& a)const
 {
 	if constexpr (IsSameType<T, R>::value)
 	{
@@ -372,7 +383,7 @@ template<class T>template<class R>	inline bool String<T>::operator==(String<R>co
 		}
 	}
 }
-template<class T>template<class R>	inline bool String<T>::operator==(R const* a)const
+template<class T, class Allocator>template<class R>	inline bool String<T, Allocator>::operator==(R const* a)const
 {
 	if constexpr (IsSameType<T, R>::value)
 	{
@@ -398,7 +409,7 @@ template<class T>template<class R>	inline bool String<T>::operator==(R const* a)
 		}
 	}
 }
-template<class T, class R>			inline bool operator==(R const* a, String<T>const& b)
+template<class T, class Allocator, class R>			inline bool operator==(R const* a, String<T, Allocator>const& b)
 {
 	if constexpr (IsSameType<T, R>::value)
 	{
@@ -425,7 +436,7 @@ template<class T, class R>			inline bool operator==(R const* a, String<T>const&
 	}
 }
 //operator+
-template<class T>template<class R>	inline auto String<T>::operator+(String<R>const& a)const
+template<class T, class Allocator>template<class R, class Allocator1>	inline auto String<T, Allocator>::operator+(String<R, Allocator1>const& a)const
 {
 	unsigned int _length, _lengthAll(1);
 	if constexpr (CharType<T>::serial + CharType<R>::serial > 2)
@@ -436,7 +447,7 @@ template<class T>template<class R>	inline auto String<T>::operator+(String<R>con
 			unsigned int tempLength((unsigned int)::mbstowcs(nullptr, data, 0));
 			_length = (tempLength + a.length);
 			while (_lengthAll < _length + 1)_lengthAll <<= 1;
-			temp = (wchar_t*)::malloc(_lengthAll << 1);
+			temp = (wchar_t*)Allocator::allocate(_lengthAll << 1);
 			::mbstowcs(temp, data, tempLength);
 			::memcpy(temp + tempLength, a.data, a.length << 1);
 			temp[_length] = 0;
@@ -448,7 +459,7 @@ template<class T>template<class R>	inline auto String<T>::operator+(String<R>con
 				unsigned int tempLength((unsigned int)::mbstowcs(nullptr, a.data, 0));
 				_length = length + tempLength;
 				while (_lengthAll < _length + 1)_lengthAll <<= 1;
-				temp = (wchar_t*)::malloc(_lengthAll << 1);
+				temp = (wchar_t*)Allocator::allocate(_lengthAll << 1);
 				::memcpy(temp, data, lengthAll << 1);
 				::mbstowcs(temp + length, a.data, tempLength);
 				temp[_length] = 0;
@@ -458,27 +469,27 @@ template<class T>template<class R>	inline auto String<T>::operator+(String<R>con
 
 				_length = length + a.length;
 				while (_lengthAll < _length + 1)_lengthAll <<= 1;
-				temp = (wchar_t*)::malloc(_lengthAll << 1);
+				temp = (wchar_t*)Allocator::allocate(_lengthAll << 1);
 				::memcpy(temp, data, length << 1);
 				::memcpy(temp + length, a.data, a.length << 1);
 				temp[_length] = 0;
 			}
 		}
-		return String<wchar_t>(temp, _length, _lengthAll);
+		return String<wchar_t, Allocator>(temp, _length, _lengthAll);
 	}
 	else
 	{
 		char* temp;
 		_length = length + a.length;
 		while (_lengthAll < _length + 1)_lengthAll <<= 1;
-		temp = (char*)::malloc(_lengthAll);
+		temp = (char*)Allocator::allocate(_lengthAll);
 		::memcpy(temp, data, length);
 		::memcpy(temp + length, a.data, a.length);
 		temp[_length] = 0;
-		return String<char>(temp, _length, _lengthAll);
+		return String<char, Allocator>(temp, _length, _lengthAll);
 	}
 }
-template<class T>template<class R>	inline auto String<T>::operator+(R const* a)const
+template<class T, class Allocator>template<class R>	inline auto String<T, Allocator>::operator+(R const* a)const
 {
 	unsigned int _length, _lengthAll(1);
 	if constexpr (CharType<T>::serial + CharType<R>::serial > 2)
@@ -490,7 +501,7 @@ template<class T>template<class R>	inline auto String<T>::operator+(R const* a)c
 			unsigned int tempLength1((unsigned int)::wcslen(a));
 			_length = (tempLength0 + tempLength1);
 			while (_lengthAll < _length + 1)_lengthAll <<= 1;
-			temp = (wchar_t*)::malloc(_lengthAll << 1);
+			temp = (wchar_t*)Allocator::allocate(_lengthAll << 1);
 			::mbstowcs(temp, data, tempLength0);
 			::memcpy(temp + tempLength0, a, tempLength1 << 1);
 			temp[_length] = 0;
@@ -502,7 +513,7 @@ template<class T>template<class R>	inline auto String<T>::operator+(R const* a)c
 				unsigned int tempLength((unsigned int)::mbstowcs(nullptr, a, 0));
 				_length = length + tempLength;
 				while (_lengthAll < _length + 1)_lengthAll <<= 1;
-				temp = (wchar_t*)::malloc(_lengthAll << 1);
+				temp = (wchar_t*)Allocator::allocate(_lengthAll << 1);
 				::memcpy(temp, data, lengthAll << 1);
 				::mbstowcs(temp + length, a, tempLength);
 				temp[_length] = 0;
@@ -512,13 +523,13 @@ template<class T>template<class R>	inline auto String<T>::operator+(R const* a)c
 				unsigned int tempLength((unsigned int)::wcslen(a));
 				_length = length + tempLength;
 				while (_lengthAll < _length + 1)_lengthAll <<= 1;
-				temp = (wchar_t*)::malloc(_lengthAll << 1);
+				temp = (wchar_t*)Allocator::allocate(_lengthAll << 1);
 				::memcpy(temp, data, length << 1);
 				::memcpy(temp + length, a, tempLength << 1);
 				temp[_length] = 0;
 			}
 		}
-		return String<wchar_t>(temp, _length, _lengthAll);
+		return String<wchar_t, Allocator>(temp, _length, _lengthAll);
 	}
 	else
 	{
@@ -526,14 +537,14 @@ template<class T>template<class R>	inline auto String<T>::operator+(R const* a)c
 		unsigned int tempLength((unsigned int)::strlen(a));
 		_length = length + tempLength;
 		while (_lengthAll < _length + 1)_lengthAll <<= 1;
-		temp = (char*)::malloc(_lengthAll);
+		temp = (char*)Allocator::allocate(_lengthAll);
 		::memcpy(temp, data, length);
 		::memcpy(temp + length, a, tempLength);
 		temp[_length] = 0;
-		return String<char>(temp, _length, _lengthAll);
+		return String<char, Allocator>(temp, _length, _lengthAll);
 	}
 }
-template<class T, class R>			inline auto operator+(R const* a, String<T>const& b)
+template<class T, class Allocator, class R>			inline auto operator+(R const* a, String<T, Allocator>const& b)
 {
 	static_assert(CharType<T>::value, "Wrong CharType!");
 	unsigned int length, lengthAll(1);
@@ -545,7 +556,7 @@ template<class T, class R>			inline auto operator+(R const* a, String<T>const& b
 			unsigned int tempLength((unsigned int)::mbstowcs(nullptr, a, 0));
 			length = (tempLength + b.length);
 			while (lengthAll < length + 1)lengthAll <<= 1;
-			temp = (wchar_t*)::malloc(lengthAll << 1);
+			temp = (wchar_t*)Allocator::allocate(lengthAll << 1);
 			::mbstowcs(temp, a, tempLength);
 			::memcpy(temp + tempLength, b.data, b.length << 1);
 			temp[length] = 0;
@@ -558,7 +569,7 @@ template<class T, class R>			inline auto operator+(R const* a, String<T>const& b
 				unsigned int tempLength1((unsigned int)::mbstowcs(nullptr, b.data, 0));
 				length = tempLength0 + tempLength1;
 				while (lengthAll < length + 1)lengthAll <<= 1;
-				temp = (wchar_t*)::malloc(lengthAll << 1);
+				temp = (wchar_t*)Allocator::allocate(lengthAll << 1);
 				::memcpy(temp, a, tempLength0 << 1);
 				::mbstowcs(temp + tempLength0, b.data, tempLength1);
 				temp[length] = 0;
@@ -568,13 +579,13 @@ template<class T, class R>			inline auto operator+(R const* a, String<T>const& b
 				unsigned int tempLength((unsigned int)::wcslen(a));
 				length = tempLength + b.length;
 				while (lengthAll < length + 1)lengthAll <<= 1;
-				temp = (wchar_t*)::malloc(lengthAll << 1);
+				temp = (wchar_t*)Allocator::allocate(lengthAll << 1);
 				::memcpy(temp, a, tempLength << 1);
 				::memcpy(temp + tempLength, b.data, b.length << 1);
 				temp[length] = 0;
 			}
 		}
-		return String<wchar_t>(temp, length, lengthAll);
+		return String<wchar_t, Allocator>(temp, length, lengthAll);
 	}
 	else
 	{
@@ -582,15 +593,15 @@ template<class T, class R>			inline auto operator+(R const* a, String<T>const& b
 		unsigned int tempLength((unsigned int)::strlen(a));
 		length = tempLength + b.length;
 		while (lengthAll < length + 1)lengthAll <<= 1;
-		temp = (char*)::malloc(lengthAll);
+		temp = (char*)Allocator::allocate(lengthAll);
 		::memcpy(temp, a, tempLength);
 		::memcpy(temp + tempLength, b.data, b.length);
 		temp[length] = 0;
-		return String<char>(temp, length, lengthAll);
+		return String<char, Allocator>(temp, length, lengthAll);
 	}
 }
 //operator+=
-template<class T>template<class R>	inline auto& String<T>::operator+=(String<R>const& a)
+template<class T, class Allocator>template<class R, class Allocator1>	inline auto& String<T, Allocator>::operator+=(String<R, Allocator1>const& a)
 {
 	if constexpr (IsSameType<T, R>::value)
 	{
@@ -598,7 +609,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(String<R>c
 		if (lengthAll <= length + a.length)
 		{
 			while (lengthAll <= length + a.length)lengthAll <<= 1;
-			data = (T*)::realloc(data, lengthAll * sizeof(T));
+			data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll * sizeof(T));
 		}
 		::memcpy(data + length, a.data, a.length * sizeof(T));
 		length += a.length;
@@ -615,7 +626,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(String<R>c
 			if (lengthAll <= length + tempLength)
 			{
 				while (lengthAll <= length + tempLength)lengthAll <<= 1;
-				data = (T*)::realloc(data, lengthAll);
+				data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll);
 			}
 			::wcstombs(data + length, a.data, tempLength + 1);
 			length += tempLength;
@@ -627,7 +638,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(String<R>c
 			if (lengthAll <= length + tempLength)
 			{
 				while (lengthAll <= length + tempLength)lengthAll <<= 1;
-				data = (T*)::realloc(data, lengthAll << 1);
+				data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll << 1);
 			}
 			::mbstowcs(data + length, a.data, tempLength + 1);
 			length += tempLength;
@@ -635,7 +646,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(String<R>c
 		return *this;
 	}
 }
-template<class T>template<class R>	inline auto& String<T>::operator+=(R const* a)
+template<class T, class Allocator>template<class R>	inline auto& String<T, Allocator>::operator+=(R const* a)
 {
 	static_assert(CharType<R>::value, "Wrong CharType!");
 	if constexpr (IsSameType<T, R>::value)
@@ -647,7 +658,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R const* a
 		{
 			lengthAll = lengthAll ? lengthAll : 1;
 			while (lengthAll <= length + tempLength)lengthAll <<= 1;
-			data = (T*)::realloc(data, lengthAll * sizeof(T));
+			data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll * sizeof(T));
 		}
 		::memcpy(data + length, a, tempLength * sizeof(T));
 		length += tempLength;
@@ -664,7 +675,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R const* a
 			if (lengthAll <= length + tempLength)
 			{
 				while (lengthAll <= length + tempLength)lengthAll <<= 1;
-				data = (T*)::realloc(data, lengthAll);
+				data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll);
 			}
 			::wcstombs(data + length, a, tempLength + 1);
 			length += tempLength;
@@ -676,7 +687,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R const* a
 			if (lengthAll <= length + tempLength)
 			{
 				while (lengthAll <= length + tempLength)lengthAll <<= 1;
-				data = (T*)::realloc(data, lengthAll << 1);
+				data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll << 1);
 			}
 			::mbstowcs(data + length, a, tempLength + 1);
 			length += tempLength;
@@ -684,7 +695,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R const* a
 		return *this;
 	}
 }
-template<class T>template<class R>	inline auto& String<T>::operator+=(R * a)
+template<class T, class Allocator>template<class R>	inline auto& String<T, Allocator>::operator+=(R * a)
 {
 	static_assert(CharType<R>::value, "Wrong CharType!");
 	if constexpr (IsSameType<T, R>::value)
@@ -696,7 +707,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R * a)
 		{
 			lengthAll = lengthAll ? lengthAll : 1;
 			while (lengthAll <= length + tempLength)lengthAll <<= 1;
-			data = (T*)::realloc(data, lengthAll * sizeof(T));
+			data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll * sizeof(T));
 		}
 		::memcpy(data + length, a, tempLength * sizeof(T));
 		length += tempLength;
@@ -713,7 +724,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R * a)
 			if (lengthAll <= length + tempLength)
 			{
 				while (lengthAll <= length + tempLength)lengthAll <<= 1;
-				data = (T*)::realloc(data, lengthAll);
+				data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll);
 			}
 			::wcstombs(data + length, a, tempLength + 1);
 			length += tempLength;
@@ -725,7 +736,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R * a)
 			if (lengthAll <= length + tempLength)
 			{
 				while (lengthAll <= length + tempLength)lengthAll <<= 1;
-				data = (T*)::realloc(data, lengthAll << 1);
+				data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll << 1);
 			}
 			::mbstowcs(data + length, a, tempLength + 1);
 			length += tempLength;
@@ -733,7 +744,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R * a)
 		return *this;
 	}
 }
-template<class T>template<class R>	inline auto& String<T>::operator+=(R a)
+template<class T, class Allocator>template<class R>	inline auto& String<T, Allocator>::operator+=(R a)
 {
 	static_assert(CharType<R>::value, "Wrong CharType!");
 	if constexpr (IsSameType<T, R>::value)
@@ -742,7 +753,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R a)
 		if (lengthAll <= length + 2)
 		{
 			lengthAll <<= 1;
-			data = (T*)::realloc(data, lengthAll * sizeof(T));
+			data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll * sizeof(T));
 		}
 		data[length++] = a;
 		data[length] = 0;
@@ -753,7 +764,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R a)
 		if (lengthAll <= length + 2)
 		{
 			lengthAll = lengthAll > 1 ? lengthAll <<= 1 : 2;
-			data = (T*)::realloc(data, lengthAll * sizeof(T));
+			data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll * sizeof(T));
 		}
 		data[length++] = a;
 		data[length] = 0;
@@ -766,7 +777,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R a)
 		if (lengthAll <= length + tempLength)
 		{
 			lengthAll = lengthAll > 2 ? lengthAll <<= 1 : 4;
-			data = (T*)::realloc(data, lengthAll * sizeof(T));
+			data = (T*)Allocator::reallocate(data, (length + 1) * sizeof(T), lengthAll * sizeof(T));
 		}
 		::wcstombs(data + length, (wchar_t*)& temp, tempLength + 1);
 		data[length += tempLength] = 0;
@@ -774,7 +785,7 @@ template<class T>template<class R>	inline auto& String<T>::operator+=(R a)
 	}
 }
 //findFirst
-template<class T>template<class R>	inline int String<T>::findFirst(String<R>const& a)
+template<class T, class Allocator>template<class R, class Allocator1>	inline int String<T, Allocator>::findFirst(String<R, Allocator1>const& a)
 {
 	T* temp;
 	if constexpr (IsSameType<T, R>::value)
@@ -790,7 +801,7 @@ template<class T>template<class R>	inline int String<T>::findFirst(String<R>cons
 	if (temp)return int(temp - data);
 	return -1;
 }
-template<class T>					inline int* String<T>::getNext()const
+template<class T, class Allocator>					inline int* String<T, Allocator>::getNext()const
 {
 	int* r((int*)::malloc(4 * length));
 	int c0(0), c1(-1);
@@ -805,7 +816,7 @@ template<class T>					inline int* String<T>::getNext()const
 	}
 	return r;
 }
-template<class T>					inline int String<T>::KMP(String<T>const& a)const
+template<class T, class Allocator>template<class Allocator1>	inline int String<T, Allocator>::KMP(String<T, Allocator1>const& a)const
 {
 	int* next(a.getNext());
 	int c0(0), c1(0);
@@ -819,19 +830,19 @@ template<class T>					inline int String<T>::KMP(String<T>const& a)const
 	if (c1 >= a.length)return c0 - a.length;
 	else return -1;
 }
-template<class T>template<class R>	inline int String<T>::findFirstKMP(String<R>const& a)
+template<class T, class Allocator>template<class R, class Allocator1>	inline int String<T, Allocator>::findFirstKMP(String<R, Allocator1>const& a)
 {
 	int temp;
 	if constexpr (IsSameType<T, R>::value)
 		temp = KMP(a);
 	else
 	{
-		if constexpr (IsSameType<T, char>::value) temp = KMP(String<char>(String<char>::transfer(a.data)));
-		else temp = KMP(String<wchar_t>(String<wchar_t>::transfer(a.data)));
+		if constexpr (IsSameType<T, char>::value) temp = KMP(String<T, Allocator>(String<T, Allocator>::transfer(a.data)));
+		else temp = KMP(String<T, Allocator>(String<T, Allocator>::transfer(a.data)));
 	}
 	return temp;
 }
-template<class T>template<class R>	inline int String<T>::findFirst(R const* a)
+template<class T, class Allocator>template<class R>	inline int String<T, Allocator>::findFirst(R const* a)
 {
 	static_assert(CharType<R>::value, "Wrong CharType!");
 	T* temp;
@@ -849,7 +860,7 @@ template<class T>template<class R>	inline int String<T>::findFirst(R const* a)
 	return -1;
 }
 //find
-template<class T>template<class R>	inline Vector<int> String<T>::find(String<R>const& a)const
+template<class T, class Allocator>template<class R, class Allocator1>	inline Vector<int> String<T, Allocator>::find(String<R, Allocator1>const& a)const
 {
 	Vector<int>temp;
 	if constexpr (IsSameType<T, R>::value)
@@ -879,7 +890,7 @@ template<class T>template<class R>	inline Vector<int> String<T>::find(String<R>c
 	}
 	else
 	{
-		T* ts(String<T>::transfer(a.data));
+		T* ts(String<T, Allocator>::transfer(a.data));
 		if constexpr (IsSameType<T, char>::value)
 		{
 			T* flag(strstr(data, ts));
@@ -904,7 +915,7 @@ template<class T>template<class R>	inline Vector<int> String<T>::find(String<R>c
 		}
 	}
 }
-template<class T>template<class R>	inline Vector<int> String<T>::find(R const* a)const
+template<class T, class Allocator>template<class R>	inline Vector<int> String<T, Allocator>::find(R const* a)const
 {
 	static_assert(CharType<R>::value, "Wrong CharType!");
 	Vector<int>temp;
@@ -935,7 +946,7 @@ template<class T>template<class R>	inline Vector<int> String<T>::find(R const* a
 	}
 	else
 	{
-		T* ts(String<T>::transfer(a));
+		T* ts(String<T, Allocator>::transfer(a));
 		if constexpr (IsSameType<T, char>::value)
 		{
 			T* flag(strstr(data, ts));
@@ -961,24 +972,24 @@ template<class T>template<class R>	inline Vector<int> String<T>::find(R const* a
 	}
 }
 //truncate: if _length < 0 then cut the left.
-template<class T>					inline String<T>String<T>::truncate(int _head, int _length)const
+template<class T, class Allocator>					inline String<T, Allocator>String<T, Allocator>::truncate(int _head, int _length)const
 {
-	if (_head < 0 || _head >= (int)length)return String<T>();
+	if (_head < 0 || _head >= (int)length)return String<T, Allocator>();
 	unsigned int _lengthAll(1);
 	if (_head + _length > (int)length || _length < 0) _length = length - _head;
 	while ((int)_lengthAll < _length + 1)_lengthAll <<= 1;
-	T * temp((T*)::malloc(_lengthAll * sizeof(T)));
+	T * temp((T*)Allocator::allocate(_lengthAll * sizeof(T)));
 	::memcpy(temp, data + _head, _length * sizeof(T));
 	temp[_length] = 0;
-	return String<T>(temp, _length, _lengthAll);
+	return String<T, Allocator>(temp, _length, _lengthAll);
 }
 //print
-template<class T>					inline void String<T>::print()const
+template<class T, class Allocator>					inline void String<T, Allocator>::print()const
 {
 	if constexpr (IsSameType<T, char>::value)::printf("%s", data);
 	else ::wprintf(L"%ls", data);
 }
-template<class T>					inline void String<T>::printInfo()const
+template<class T, class Allocator>					inline void String<T, Allocator>::printInfo()const
 {
 	if constexpr (IsSameType<T, char>::value)::printf("[\"%s\", %u ,%u]\n", data, length, lengthAll);
 	else ::wprintf(L"[\"%ls\", %u ,%u]\n", data, length, lengthAll);
@@ -66,6 +66,10 @@ template<class Condition>struct Not
 	using Result = If<Condition, FalseCondition, TrueCondition>;
 };
 
+//Types that can be moved to another address by a plain memcpy, without calling
+//the move constructor and the destructor. Specialize it for your own types...
+template<class T>struct IsTriviallyRelocatable : BoolConstant<__is_trivially_copyable(T)> {};
+
 //==============================================
 template<class T>struct NumType
 {
@@ -13,6 +13,7 @@ struct Timer
 	void end();
 	void print();
 	void print(const char* a);
+	long long nanoseconds()const;
 };
 struct FPS
 {
@@ -63,6 +64,11 @@ inline void Timer::print(const char* a)
 	printf(a);
 	print();
 }
+//nanoseconds between begin() and end()
+inline long long Timer::nanoseconds()const
+{
+	return 1000000000LL * (ending.tv_sec - begining.tv_sec) + (ending.tv_nsec - begining.tv_nsec);
+}
 //==================FPS==================
 inline FPS::FPS()
 	:
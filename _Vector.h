@@ -1,11 +1,83 @@
 #pragma once
 #include <new>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <cmath>
+#include <utility>
+#include <type_traits>
 #include <initializer_list>
+#include <_TemplateMeta.h>
+#include <_Allocator.h>
 
-template<class T>struct Vector
+//Placement-construct, aggregates (most structs here) are brace-initialized
+template<class T, class... Args>inline void construct(T* p, Args&&... args)
+{
+	if constexpr (std::is_constructible<T, Args...>::value)
+		new(p)T(std::forward<Args>(args)...);
+	else
+		new(p)T{ std::forward<Args>(args)... };
+}
+//Move n elements from src to uninitialized dst and leave src uninitialized,
+//ranges may overlap (used for shifting inside one buffer too)
+template<class T>inline void relocate(T* dst, T* src, int n)
+{
+	if (n <= 0 || dst == src)return;
+	if constexpr (IsTriviallyRelocatable<T>::value)
+		::memmove(dst, src, n * sizeof(T));
+	else if (dst < src)
+	{
+		for (int c1 = 0; c1 < n; c1++)
+		{
+			new(dst + c1)T(std::move(src[c1]));
+			(src + c1)->~T();
+		}
+	}
+	else
+	{
+		for (int c1 = n - 1; c1 >= 0; c1--)
+		{
+			new(dst + c1)T(std::move(src[c1]));
+			(src + c1)->~T();
+		}
+	}
+}
+
+//Growth policy of Vector: when full the capacity is multiplied by _num / _den,
+//when the length drops to 1 / _shrink of the capacity the capacity is divided by
+//_num / _den. _shrink must exceed the growth factor so a push right after a shrink
+//never reallocates again, _shrink = 0 means never shrink.
+template<unsigned int _num = 2, unsigned int _den = 1, unsigned int _shrink = 4>struct VectorGrowth
+{
+	static_assert(_den && _num > _den, "Vector must grow!");
+	static_assert(!_shrink || _shrink * _den > _num, "Shrink threshold must be below 1 / growth factor!");
+	//capacity to hold at least _length elements, starting from _lengthAll
+	static int grow(int _lengthAll, int _length)
+	{
+		if (!_lengthAll)_lengthAll = 1;
+		while (_lengthAll < _length)
+		{
+			int t((int)((long long)_lengthAll * _num / _den));
+			_lengthAll = t > _lengthAll ? t : _lengthAll + 1;
+		}
+		return _lengthAll;
+	}
+	//capacity to keep once the length dropped to _length, _lengthAll means keep the buffer
+	static int shrink(int _lengthAll, int _length)
+	{
+		if constexpr (!_shrink)return _lengthAll;
+		else
+		{
+			if ((long long)_length * _shrink > _lengthAll)return _lengthAll;
+			int t((int)((long long)_lengthAll * _den / _num));
+			return t > _length ? t : _length;
+		}
+	}
+};
+using DefaultGrowth = VectorGrowth<>;
+using NeverShrink = VectorGrowth<2, 1, 0>;
+
+template<class T, class Growth = DefaultGrowth, class Allocator = DefaultAllocator>struct Vector
 {
 	using elementType = T;
 	T* data;
@@ -14,19 +86,25 @@ template<class T>struct Vector
 	//Construction
 	Vector();
 	Vector(std::initializer_list<T>const&);
-	Vector(Vector<T>const&);
-	template<class R>Vector(Vector<R>const&);
+	Vector(Vector<T, Growth, Allocator>const&);
+	Vector(Vector<T, Growth, Allocator>&&);
+	template<class R, class Growth1, class Allocator1>Vector(Vector<R, Growth1, Allocator1>const&);
 	Vector(T const&);
 	//Destruction
 	~Vector();
 	//opetrator=
-	Vector<T>& operator=	(Vector<T>&&);
-	Vector<T>& operator=	(const Vector<T>&);
+	Vector<T, Growth, Allocator>& operator=	(Vector<T, Growth, Allocator>&&);
+	Vector<T, Growth, Allocator>& operator=	(const Vector<T, Growth, Allocator>&);
 	//opetrator+
-	Vector<T>	operator+	(const Vector<T>&);
-	Vector<T>& operator+=	(const Vector<T>&);
-	//malloc
-	Vector<T>& malloc(unsigned int);
+	Vector<T, Growth, Allocator>	operator+	(const Vector<T, Growth, Allocator>&)const&;
+	Vector<T, Growth, Allocator>	operator+	(const Vector<T, Growth, Allocator>&)&&;
+	Vector<T, Growth, Allocator>& operator+=	(const Vector<T, Growth, Allocator>&);
+	//capacity
+	Vector<T, Growth, Allocator>& malloc(unsigned int);
+	Vector<T, Growth, Allocator>& reserve(unsigned int);
+	Vector<T, Growth, Allocator>& resize(unsigned int);
+	Vector<T, Growth, Allocator>& shrinkToFit();
+	Vector<T, Growth, Allocator>& reallocate(int);
 	//element
 	T& begin();
 	T& end();
@@ -37,171 +115,227 @@ template<class T>struct Vector
 	Vector<unsigned int>posAll(T const&)const;
 	//Find element
 	template<class R>T& findFirst(bool(*cmp)(T const&, R const&), R const&);
+	template<class F, class R>T& findFirst(F&&, R const&);
 	T& findFirst(T const&);
 	Vector<T*> find(T const&);
 
 	//add...
 	Vector& pushBack();
 	Vector& pushBack(const T&);
+	Vector& pushBack(T&&);
+	template<class... Args>Vector& emplaceBack(Args&&...);
 	Vector& popBack();
 	Vector& insert(T&&, unsigned int);
 	Vector& omit(unsigned int);
+	Vector& eraseRange(unsigned int, unsigned int);
+	Vector& swapErase(unsigned int);
+	template<class F>Vector& removeIf(F&&);
 	//traverse
 	bool traverse(bool(*p)(T&));
 	bool traverse(bool(*p)(T const&))const;
+	template<class F>bool traverse(F&&);
+	template<class F>bool traverse(F&&)const;
 };
+//Vector only owns a pointer to its buffer, so it can be moved by memcpy
+template<class T, class Growth, class Allocator>struct IsTriviallyRelocatable<Vector<T, Growth, Allocator>> :True {};
+//Vector whose buffer always starts on a multiple of _alignment, see AlignedAllocator
+template<class T, size_t _alignment = 64, class Growth = DefaultGrowth>using AlignedVector = Vector<T, Growth, AlignedAllocator<_alignment>>;
 //Construction
-template<class T>inline Vector<T>::Vector()
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>::Vector()
 {
 	data = nullptr;
 	lengthAll = length = 0;
 }
-template<class T>inline Vector<T>::Vector(std::initializer_list<T>const& a)
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>::Vector(std::initializer_list<T>const& a)
 {
 	length = (int)a.size();
-	lengthAll = 1;
-	while (lengthAll < length)
-		lengthAll <<= 1;
-	data = (T*)std::malloc(lengthAll * sizeof(T));
+	lengthAll = Growth::grow(0, length);
+	data = (T*)ElementAllocator<Allocator, T>::allocate(lengthAll * sizeof(T));
 	for (int c1 = 0; c1 < length; c1++)
 		new(data + c1)T(*(a.begin() + c1));
 }
-template<class T>inline Vector<T>::Vector(Vector<T>const& a)
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>::Vector(Vector<T, Growth, Allocator>const& a)
 {
 	if (this == &a)return;
 	lengthAll = a.lengthAll;
 	length = a.length;
-	data = (T*)std::malloc(a.lengthAll * sizeof(T));
+	data = (T*)ElementAllocator<Allocator, T>::allocate(a.lengthAll * sizeof(T));
 	for (int c1 = 0; c1 < length; c1++)
 		new(data + c1)T(a.data[c1]);
 }
-template<class T>template<class R>inline Vector<T>::Vector(Vector<R>const& a)
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>::Vector(Vector<T, Growth, Allocator> && a)
+	:
+	data(a.data),
+	length(a.length),
+	lengthAll(a.lengthAll)
+{
+	a.data = nullptr;
+	a.lengthAll = a.length = 0;
+}
+template<class T, class Growth, class Allocator>template<class R, class Growth1, class Allocator1>inline Vector<T, Growth, Allocator>::Vector(Vector<R, Growth1, Allocator1>const& a)
 {
 	lengthAll = a.lengthAll;
 	length = a.length;
-	data = (T*)std::malloc(a.lengthAll * sizeof(T));
+	data = (T*)ElementAllocator<Allocator, T>::allocate(a.lengthAll * sizeof(T));
 	for (int c1 = 0; c1 < length; c1++)
 		new(data + c1)T(a.data[c1]);
 }
-template<class T>inline Vector<T>::Vector(T const& a)
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>::Vector(T const& a)
 	:
-	data((T*)::malloc(2 * sizeof(T))),
+	data((T*)ElementAllocator<Allocator, T>::allocate(2 * sizeof(T))),
 	length(1),
 	lengthAll(2)
 {
 	new(data)T(a);
 }
 //Destruction
-template<class T>inline Vector<T>::~Vector()
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>::~Vector()
 {
 	if (data)
 	{
 		for (int c1 = 0; c1 < length; c1++)(data + c1)->~T();
-		free(data);
+		ElementAllocator<Allocator, T>::deallocate(data, lengthAll * sizeof(T));
 		data = nullptr;
 	}
 }
 //opetrator=
-template<class T>inline Vector<T>& Vector<T>::operator= (Vector<T> && a)
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::operator= (Vector<T, Growth, Allocator> && a)
 {
 	if (this == &a)return *this;
-	lengthAll = a.lengthAll;
+	this->~Vector();
+	data = a.data;
 	length = a.length;
-	data = (T*)std::malloc(a.lengthAll * sizeof(T));
-	for (int c1 = 0; c1 < length; c1++)
-		new(data + c1)T(a.data[c1]);
+	lengthAll = a.lengthAll;
+	a.data = nullptr;
+	a.lengthAll = a.length = 0;
 	return *this;
 }
-template<class T>inline Vector<T> & Vector<T>::operator= (Vector<T>const& a)
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator> & Vector<T, Growth, Allocator>::operator= (Vector<T, Growth, Allocator>const& a)
 {
 	if (this == &a)return *this;
 	this->~Vector();
 	lengthAll = a.lengthAll;
 	length = a.length;
-	data = (T*)std::malloc(a.lengthAll * sizeof(T));
+	data = (T*)ElementAllocator<Allocator, T>::allocate(a.lengthAll * sizeof(T));
 	for (int c1 = 0; c1 < length; c1++)
 		new(data + c1)T(a.data[c1]);
 	return *this;
 }
 //operator+
-template<class T>inline Vector<T>	Vector<T>::operator+ (Vector<T>const& a)
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>	Vector<T, Growth, Allocator>::operator+ (Vector<T, Growth, Allocator>const& a)const&
 {
-	Vector<T>* tp = new Vector<T>;
-	tp->lengthAll = 1 << (1 + (int)log2(tp->length = length + a.length));
-	tp->data = (T*)std::malloc(tp->lengthAll * sizeof(T));
+	Vector<T, Growth, Allocator>r;
+	if (!(length + a.length))return r;
+	r.lengthAll = Growth::grow(0, r.length = length + a.length);
+	r.data = (T*)ElementAllocator<Allocator, T>::allocate(r.lengthAll * sizeof(T));
 	for (int c1 = 0; c1 < length; c1++)
-		new(tp->data + c1)T(data[c1]);
+		new(r.data + c1)T(data[c1]);
 	for (int c1 = 0; c1 < a.length; c1++)
-		new(tp->data + c1 + length)T(a.data[c1]);
-	return *tp;
+		new(r.data + c1 + length)T(a.data[c1]);
+	return r;
+}
+//a temporary on the left (like a + b + c) is appended in place and moved out
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>	Vector<T, Growth, Allocator>::operator+ (Vector<T, Growth, Allocator>const& a)&&
+{
+	*this += a;
+	return std::move(*this);
 }
-template<class T>inline Vector<T> & Vector<T>::operator+=(Vector<T>const& a)
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator> & Vector<T, Growth, Allocator>::operator+=(Vector<T, Growth, Allocator>const& a)
 {
 	if (length + a.length <= lengthAll)
 	{
-		for (int c1 = 0; c1 < a.length; c1++)
+		int n(a.length);
+		for (int c1 = 0; c1 < n; c1++)
 			new(data + c1 + length)T(a.data[c1]);
+		length += n;
 		return *this;
 	}
-	lengthAll = 1 << (1 + (int)log2(length + a.length));
-	T * tp = (T*)std::malloc(lengthAll * sizeof(T));
-	for (int c1 = 0; c1 < length; c1++)
-		new(tp + c1)T(data[c1]);
+	int _lengthAll(Growth::grow(lengthAll, length + a.length));
+	T * tp = (T*)ElementAllocator<Allocator, T>::allocate(_lengthAll * sizeof(T));
 	for (int c1 = 0; c1 < a.length; c1++)
 		new(tp + c1 + length)T(a.data[c1]);
-	for (int c1 = 0; c1 < length; c1++)
-		(data + c1)->~T();
-	free(data);
+	relocate(tp, data, length);
+	ElementAllocator<Allocator, T>::deallocate(data, lengthAll * sizeof(T));
 	data = tp;
+	lengthAll = _lengthAll;
 	length += a.length;
 	return *this;
 }
-//malloc
-template<class T>inline Vector<T> & Vector<T>::malloc(unsigned int a)
+//capacity
+//malloc: append a uninitialized elements, only meant for plain data filled in by hand
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator> & Vector<T, Growth, Allocator>::malloc(unsigned int a)
 {
 	if (!a)return *this;
 	if (length + a > lengthAll)
+		reallocate(Growth::grow(lengthAll, length + a));
+	length += a;
+	return *this;
+}
+//reserve: make room for at least a elements, length is untouched
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::reserve(unsigned int a)
+{
+	if ((int)a > lengthAll)reallocate(a);
+	return *this;
+}
+//resize: default-construct or destroy elements at the end, never shrinks the buffer
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::resize(unsigned int a)
+{
+	if ((int)a > lengthAll)
+		reallocate(Growth::grow(lengthAll, a));
+	while (length < (int)a)new(data + length++)T();
+	while (length > (int)a)(data + --length)->~T();
+	return *this;
+}
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::shrinkToFit()
+{
+	if (length < lengthAll)reallocate(length);
+	return *this;
+}
+//reallocate: move the elements into a new buffer of a elements (a >= length),
+//trivially relocatable elements let the allocator grow the block in place
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::reallocate(int a)
+{
+	if constexpr (IsTriviallyRelocatable<T>::value)
 	{
-		if (!lengthAll)lengthAll = 1;
-		while (length + a > lengthAll)lengthAll <<= 1;
-		T * tp = (T*)std::malloc(lengthAll * sizeof(T));
-		for (int c1 = 0; c1 < length; c1++)
+		if (a && data)
 		{
-			new(tp + c1)T(data[c1]);
-			(data + c1)->~T();
+			data = (T*)ElementAllocator<Allocator, T>::reallocate(data, length * sizeof(T), a * sizeof(T));
+			lengthAll = a;
+			return *this;
 		}
-		length += a;
-		free(data);
-		data = tp;
-		return *this;
 	}
-	else return *this;
+	T* tp(a ? (T*)ElementAllocator<Allocator, T>::allocate(a * sizeof(T)) : nullptr);
+	relocate(tp, data, length);
+	ElementAllocator<Allocator, T>::deallocate(data, lengthAll * sizeof(T));
+	data = tp;
+	lengthAll = a;
+	return *this;
 }
 //element
-template<class T>inline T& Vector<T>::begin()
+template<class T, class Growth, class Allocator>inline T& Vector<T, Growth, Allocator>::begin()
 {
 	return data[0];
 }
-template<class T>inline T& Vector<T>::end()
+template<class T, class Growth, class Allocator>inline T& Vector<T, Growth, Allocator>::end()
 {
 	return data[length - 1];
 }
-template<class T>inline T* Vector<T>::endptr()
+template<class T, class Growth, class Allocator>inline T* Vector<T, Growth, Allocator>::endptr()
 {
 	return data + length - 1;
 }
-template<class T>inline T& Vector<T>::operator[](unsigned int a)
+template<class T, class Growth, class Allocator>inline T& Vector<T, Growth, Allocator>::operator[](unsigned int a)
 {
 	return data[a];
 }
 //Find position
-template<class T>inline int Vector<T>::posFirst(T const& a)const
+template<class T, class Growth, class Allocator>inline int Vector<T, Growth, Allocator>::posFirst(T const& a)const
 {
 	for (int c1 = 0; c1 < length; c1++)
 		if (data[c1] == a)return c1;
 	return -1;
 }
-template<class T>inline Vector<unsigned int> Vector<T>::posAll(T const& a) const
+template<class T, class Growth, class Allocator>inline Vector<unsigned int> Vector<T, Growth, Allocator>::posAll(T const& a) const
 {
 	Vector<unsigned int>r;
 	for (int c1(0); c1 < length; c1++)
@@ -209,19 +343,25 @@ template<class T>inline Vector<unsigned int> Vector<T>::posAll(T const& a) const
 	return r;
 }
 //Find element
-template<class T>template<class R>inline T & Vector<T>::findFirst(bool(*cmp)(T const&, R const&), R const& a)
+template<class T, class Growth, class Allocator>template<class R>inline T & Vector<T, Growth, Allocator>::findFirst(bool(*cmp)(T const&, R const&), R const& a)
 {
 	for (int c1 = 0; c1 < length; c1++)
 		if (cmp(data[c1], a))return data[c1];
 	return *(T*)NULL;
 }
-template<class T>inline T& Vector<T>::findFirst(T const& a)
+template<class T, class Growth, class Allocator>template<class F, class R>inline T& Vector<T, Growth, Allocator>::findFirst(F&& cmp, R const& a)
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (cmp(data[c1], a))return data[c1];
+	return *(T*)NULL;
+}
+template<class T, class Growth, class Allocator>inline T& Vector<T, Growth, Allocator>::findFirst(T const& a)
 {
 	for (int c1 = 0; c1 < length; c1++)
 		if (data[c1] == a)return data[c1];
 	return *(T*)NULL;
 }
-template<class T>inline Vector<T*> Vector<T>::find(T const& a)
+template<class T, class Growth, class Allocator>inline Vector<T*> Vector<T, Growth, Allocator>::find(T const& a)
 {
 	Vector<T*>r;
 	for (int c1(0); c1 < length; c1++)
@@ -230,142 +370,132 @@ template<class T>inline Vector<T*> Vector<T>::find(T const& a)
 
 }
 //add...
-template<class T>inline Vector<T> & Vector<T>::pushBack()
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator> & Vector<T, Growth, Allocator>::pushBack()
 {
-	if (lengthAll == length)
-	{
-		lengthAll = (lengthAll ? (lengthAll << 1) : 1);
-		T * tp = (T*)std::malloc(lengthAll * sizeof(T));
-		for (int c1 = 0; c1 < length; c1++)
-		{
-			new(tp + c1)T(data[c1]);
-			(data + c1)->~T();
-		}
-		free(data);
-		data = tp;
-	}
-	new(data + length++)T();
-	return *this;
+	return emplaceBack();
+}
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::pushBack(T const& a)
+{
+	return emplaceBack(a);
 }
-template<class T>inline Vector<T>& Vector<T>::pushBack(T const& a)
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::pushBack(T && a)
+{
+	return emplaceBack(std::move(a));
+}
+template<class T, class Growth, class Allocator>template<class... Args>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::emplaceBack(Args&&... args)
 {
 	if (lengthAll == length)
 	{
-		lengthAll = (lengthAll ? (lengthAll << 1) : 1);
-		T * tp = (T*)std::malloc(lengthAll * sizeof(T));
-		if (&a >= data && &a < data + length)
-		{
-			T temp(a);
-			for (int c1 = 0; c1 < length; c1++)
-			{
-				new(tp + c1)T(data[c1]);
-				(data + c1)->~T();
-			}
-			free(data);
-			data = tp;
-			new(data + length++)T(temp);
-		}
-		else
-		{
-			for (int c1 = 0; c1 < length; c1++)
-			{
-				new(tp + c1)T(data[c1]);
-				(data + c1)->~T();
-			}
-			free(data);
-			data = tp;
-			new(data + length++)T(a);
-		}
+		int _lengthAll(Growth::grow(lengthAll, length + 1));
+		T * tp = (T*)ElementAllocator<Allocator, T>::allocate(_lengthAll * sizeof(T));
+		//args may refer to elements of this, so build it before the old buffer goes away
+		construct(tp + length, std::forward<Args>(args)...);
+		relocate(tp, data, length++);
+		ElementAllocator<Allocator, T>::deallocate(data, lengthAll * sizeof(T));
+		data = tp;
+		lengthAll = _lengthAll;
 	}
 	else
-		new(data + length++)T(a);
+		construct(data + length++, std::forward<Args>(args)...);
 	return *this;
 }
-template<class T>inline Vector<T>& Vector<T>::popBack()
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::popBack()
 {
-	if (--length <= (lengthAll >> 2))
-	{
-		lengthAll >>= 1;
-		T* tp = (T*)std::malloc(lengthAll * sizeof(T));
-		for (int c1 = 0; c1 < length; c1++)
-		{
-			new(tp + c1)T(data[c1]);
-			(data + c1)->~T();
-		}
-		(data + length)->~T();
-		free(data);
-		data = tp;
-	}
-	else
-		(data + length)->~T();
+	(data + --length)->~T();
+	int t(Growth::shrink(lengthAll, length));
+	if (t != lengthAll)reallocate(t);
 	return *this;
 }
-template<class T>inline Vector<T> & Vector<T>::insert(T && a, unsigned int b)
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator> & Vector<T, Growth, Allocator>::insert(T && a, unsigned int b)
 {
-	if (b == length)return pushBack(a);
+	if (b == length)return pushBack(std::move(a));
 	if (lengthAll == length)
 	{
-		lengthAll = (lengthAll ? (lengthAll << 1) : 1);
-		T * tp = (T*)std::malloc(lengthAll * sizeof(T));
-		for (int c1 = 0; c1 < b; c1++)
-		{
-			new(tp + c1)T(data[c1]);
-			(data + c1)->~T();
-		}
-		for (int c1 = b + 1; c1 <= length; c1++)
-		{
-			new(tp + c1)T(data[c1]);
-			(data + c1)->~T();
-		}
-		free(data);
+		int _lengthAll(Growth::grow(lengthAll, length + 1));
+		T * tp = (T*)ElementAllocator<Allocator, T>::allocate(_lengthAll * sizeof(T));
+		relocate(tp, data, b);
+		relocate(tp + b + 1, data + b, length - b);
+		ElementAllocator<Allocator, T>::deallocate(data, lengthAll * sizeof(T));
 		data = tp;
+		lengthAll = _lengthAll;
 	}
 	else
-	{
-		for (int c1 = length - 1; c1 >= b; c1--)
-		{
-			new(data + c1 + 1)T(data[c1]);
-			(data + c1)->~T();
-		}
-	}
+		relocate(data + b + 1, data + b, length - b);
 	length++;
-	new(data + b)T(a);
+	new(data + b)T(std::move(a));
 	return *this;
 }
-template<class T>inline Vector<T>& Vector<T>::omit(unsigned int b)
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::omit(unsigned int b)
 {
 	if (b == length - 1)
 		return popBack();
-	if (--length <= (lengthAll >> 2))
-	{
-		lengthAll >>= 1;
-	}
-	T* tp = (T*)std::malloc(lengthAll * sizeof(T));
-	for (int c1 = 0; c1 < b; c1++)
+	(data + b)->~T();
+	int t(Growth::shrink(lengthAll, --length));
+	if (t != lengthAll)
 	{
-		new(tp + c1)T(data[c1]);
-		(data + c1)->~T();
+		T* tp(t ? (T*)ElementAllocator<Allocator, T>::allocate(t * sizeof(T)) : nullptr);
+		relocate(tp, data, b);
+		relocate(tp + b, data + b + 1, length - b);
+		ElementAllocator<Allocator, T>::deallocate(data, lengthAll * sizeof(T));
+		data = tp;
+		lengthAll = t;
 	}
-	(data + b)->~T();
-	for (int c1 = b + 1; c1 <= length; c1++)
+	else
+		relocate(data + b, data + b + 1, length - b);
+	return *this;
+}
+//erase [a, b) in place, the buffer is kept
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::eraseRange(unsigned int a, unsigned int b)
+{
+	if (b > (unsigned int)length)b = length;
+	if (a >= b)return *this;
+	for (unsigned int c1 = a; c1 < b; c1++)(data + c1)->~T();
+	relocate(data + a, data + b, length - b);
+	length -= b - a;
+	return *this;
+}
+//erase by moving the last element into the hole, O(1) but changes the order
+template<class T, class Growth, class Allocator>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::swapErase(unsigned int a)
+{
+	(data + a)->~T();
+	relocate(data + a, data + --length, 1);
+	return *this;
+}
+//erase all elements that p(element) is true in one pass, keeping the order and the buffer
+template<class T, class Growth, class Allocator>template<class F>inline Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::removeIf(F&& p)
+{
+	int c0(0);
+	for (int c1 = 0; c1 < length; c1++)
 	{
-		new(tp + c1 - 1)T(data[c1]);
-		(data + c1)->~T();
+		if (p(data[c1]))(data + c1)->~T();
+		else relocate(data + c0++, data + c1, 1);
 	}
-	free(data);
-	data = tp;
+	length = c0;
 	return *this;
 }
 //traverse
-template<class T>inline bool Vector<T>::traverse(bool(*p)(T&))
+template<class T, class Growth, class Allocator>inline bool Vector<T, Growth, Allocator>::traverse(bool(*p)(T&))
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (!p(data[c1]))return false;
+	return true;
+}
+template<class T, class Growth, class Allocator>inline bool Vector<T, Growth, Allocator>::traverse(bool(*p)(T const&))const
 {
 	for (int c1 = 0; c1 < length; c1++)
 		if (!p(data[c1]))return false;
 	return true;
 }
-template<class T>inline bool Vector<T>::traverse(bool(*p)(T const&))const
+//traverse with any callable (lambdas with captures too), can be inlined
+template<class T, class Growth, class Allocator>template<class F>inline bool Vector<T, Growth, Allocator>::traverse(F&& p)
 {
 	for (int c1 = 0; c1 < length; c1++)
 		if (!p(data[c1]))return false;
 	return true;
 }
+template<class T, class Growth, class Allocator>template<class F>inline bool Vector<T, Growth, Allocator>::traverse(F&& p)const
+{
+	for (int c1 = 0; c1 < length; c1++)
+		if (!p((T const&)data[c1]))return false;
+	return true;
+}
\ No newline at end of file